@@ -0,0 +1,162 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/* Desc:    Monotonic arena allocation of states and solutions, released in bulk
+ */
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+
+namespace moveit {
+namespace task_constructor {
+
+MOVEIT_CLASS_FORWARD(Arena);
+
+/** Monotonic memory pool providing the storage of states and solutions created during planning
+ *
+ * Allocation bumps a pointer within the current chunk (lock-free), only acquiring new chunks is serialized.
+ * Deallocation doesn't return memory: all chunks are released as a whole when the arena is destroyed.
+ *
+ * Each Task owns an Arena, which is replaced by a fresh one on Task::reset().
+ * Allocators keep their arena alive, such that objects outliving the reset (e.g. solutions held by the user)
+ * remain valid. Once all of its objects are destroyed, the arena releases its memory in one go.
+ * Hence, solutions retained for a long time should be copied out (e.g. via toMsg()) to not pin a whole arena.
+ *
+ * As memory of destroyed objects is not reused, planning without reset (e.g. discarding many solutions)
+ * lets the arena grow. Once max_reserved bytes were acquired, further requests fall back to upstream
+ * and are returned there on deallocation.
+ */
+class Arena : public std::pmr::memory_resource
+{
+public:
+	static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+	static constexpr std::size_t DEFAULT_MAX_RESERVED = 256 * 1024 * 1024;
+
+	/// create an arena acquiring chunks of (at least) chunk_size bytes from upstream, up to max_reserved bytes
+	explicit Arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE,
+	               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+	               std::size_t max_reserved = DEFAULT_MAX_RESERVED);
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+	/// release all chunks
+	~Arena() override;
+
+	/// number of bytes currently allocated from this arena (and not yet deallocated)
+	std::size_t allocatedBytes() const { return allocated_; }
+	/// number of bytes acquired from upstream, kept until destruction
+	std::size_t reservedBytes() const { return reserved_; }
+	/// number of chunks acquired from upstream
+	std::size_t numChunks() const { return num_chunks_; }
+	/// number of bytes currently allocated directly from upstream, because max_reserved was reached
+	std::size_t overflowBytes() const { return overflow_bytes_; }
+
+private:
+	struct Chunk;
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+	/// acquire a new chunk providing at least bytes with given alignment (called with mutex_ locked)
+	/// returns nullptr if this would exceed max_reserved_
+	Chunk* acquireChunk(std::size_t bytes, std::size_t alignment);
+	/// does p belong to one of the chunks? (called with mutex_ locked)
+	bool ownsChunkMemory(const void* p) const;
+
+	const std::size_t chunk_size_;
+	const std::size_t max_reserved_;
+	std::pmr::memory_resource* const upstream_;
+	std::atomic<Chunk*> current_{ nullptr };  // chunk serving allocations
+	Chunk* chunks_ = nullptr;  // all chunks (linked list), guarded by mutex_
+	std::map<std::uintptr_t, std::size_t> chunk_ranges_;  // (address, size) of all chunks, guarded by mutex_
+	std::atomic<bool> overflown_{ false };  // were there allocations from upstream?
+	std::mutex mutex_;
+
+	std::atomic<std::size_t> allocated_{ 0 };
+	std::atomic<std::size_t> reserved_{ 0 };
+	std::atomic<std::size_t> num_chunks_{ 0 };
+	std::atomic<std::size_t> overflow_bytes_{ 0 };
+};
+
+/// Allocator drawing memory from an Arena (or from the heap if there is none), keeping the arena alive
+template <typename T>
+class ArenaAllocator
+{
+	template <typename U>
+	friend class ArenaAllocator;
+
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	ArenaAllocator(ArenaPtr arena = ArenaPtr()) noexcept : arena_(std::move(arena)) {}
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(resource()->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* p, std::size_t n) { resource()->deallocate(p, n * sizeof(T), alignof(T)); }
+
+	const ArenaPtr& arena() const { return arena_; }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>& other) const {
+		return arena_ == other.arena_;
+	}
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const {
+		return arena_ != other.arena_;
+	}
+
+private:
+	std::pmr::memory_resource* resource() const {
+		return arena_ ? static_cast<std::pmr::memory_resource*>(arena_.get()) : std::pmr::new_delete_resource();
+	}
+
+	ArenaPtr arena_;
+};
+}  // namespace task_constructor
+}  // namespace moveit
@@ -39,6 +39,7 @@
 #pragma once
 
 #include "stage.h"
+#include "scheduler.h"
 
 namespace moveit {
 namespace task_constructor {
@@ -55,6 +56,10 @@ public:
 	void setPruning(bool pruning) { setProperty("pruning", pruning); }
 	bool pruning() const { return properties().get<bool>("pruning"); }
 
+	/// Configure the policy selecting the children to compute in each step (inherited by child containers)
+	void setSchedulerPolicy(const SchedulerPolicyConstPtr& policy) { setProperty("scheduler", policy); }
+	SchedulerPolicyConstPtr schedulerPolicy() const { return properties().get<SchedulerPolicyConstPtr>("scheduler"); }
+
 	size_t numChildren() const;
 	Stage* findChild(const std::string& name) const;
 	Stage* operator[](int index) const;
@@ -98,9 +103,29 @@ public:
 	PRIVATE_CLASS(SerialContainer)
 	SerialContainer(const std::string& name = "serial container");
 
+	void reset() override;
 	bool canCompute() const override;
 	void compute() override;
 
+	/** Assemble full solutions incrementally (default: false)
+	 *
+	 * By default, each new child solution triggers the enumeration of all partial solution paths
+	 * extending it backward and forward, which grows combinatorially with the number of children and solutions.
+	 * If enabled, the best partial path priorities toward the container's start and end are maintained per state
+	 * and updated incrementally. Only paths reaching both ends of the container are enumerated then.
+	 * Note that states are then prioritized by the best partial path passing through them.
+	 */
+	void setIncrementalAssembly(bool enable) { setProperty("incremental_assembly", enable); }
+
+	/** Lazily enumerate full solutions in increasing cost order (default: false)
+	 *
+	 * Full solution paths are not lifted immediately, but kept as pending candidates.
+	 * Each compute() call lifts the cheapest pending solution (instead of computing the children),
+	 * such that only as many solutions are created as requested, best ones first.
+	 * Implies incremental assembly.
+	 */
+	void setLazyEnumeration(bool enable) { setProperty("lazy_enumeration", enable); }
+
 protected:
 	void onNewSolution(const SolutionBase& s) override;
 
@@ -144,6 +169,7 @@ protected:
 /** Plan for different alternatives in parallel.
  *
  * Solution of all children are reported - sorted by cost.
+ * If the task computes concurrently, children supporting it are computed in parallel.
  */
 class Alternatives : public ParallelContainerBase
 {
@@ -162,6 +188,10 @@ class FallbacksPrivate;
  * Try to find feasible solutions using first child. Only if this fails,
  * proceed to the next child trying an alternative planning strategy.
  * All solutions of the last active child are reported.
+ *
+ * For propagating children, the current job can be computed speculatively by the next
+ * `speculative_children` children in parallel (if the task computes concurrently).
+ * Results of lower-priority children are discarded as soon as a higher-priority child succeeded.
  */
 class Fallbacks : public ParallelContainerBase
 {
@@ -174,6 +204,9 @@ public:
 	void reset() override;
 	void init(const moveit::core::RobotModelConstPtr& robot_model) override;
 
+	/// number of subsequent children to compute speculatively in parallel to the current one
+	void setSpeculativeChildren(uint32_t num) { setProperty("speculative_children", num); }
+
 protected:
 	Fallbacks(FallbacksPrivate* impl);
 	void onNewSolution(const SolutionBase& s) override;
@@ -42,12 +42,14 @@
 #include <moveit/macros/class_forward.hpp>
 #include "stage_p.h"
 
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
-#include <boost/bimap/unordered_multiset_of.hpp>
-
 #include <map>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 #include <climits>
+#include <limits>
+#include <exception>
+#include <functional>
 
 namespace moveit {
 namespace core {
@@ -117,22 +119,86 @@ public:
 	bool canCompute() const override;
 	void compute() override;
 
+	/** Compute given children concurrently, using the task's thread pool.
+	 *
+	 * Updates of the solution graph are recorded during computation and replayed afterwards,
+	 * sequentially in the order of the given children. Thus the result is deterministic.
+	 * Exceptions are rethrown after all children have finished and their commits were replayed.
+	 */
+	void computeConcurrently(const std::vector<StagePrivate*>& children);
+	/** Run given jobs concurrently using the task's thread pool, recording their commits into corresponding buffers.
+	 *
+	 * Returns the first exception thrown by any job, after all of them have finished.
+	 * The buffers are not replayed, leaving it to the caller to decide which results to commit.
+	 */
+	std::exception_ptr recordConcurrently(const std::vector<std::function<void()>>& jobs,
+	                                      std::vector<CommitBuffer>& buffers);
+
+	/// Children ready to compute, selected and ordered by the configured SchedulerPolicy
+	std::vector<StagePrivate*> scheduledChildren() const;
+	/// Compute given children (in order), dispatching them to the thread pool if possible
+	void computeChildren(const std::vector<StagePrivate*>& children);
+
+	/// most promising priority pending in any of the children
+	InterfaceState::Priority pendingPriority() const override;
+
 	// internal interface for first/last child to push to if required
 	InterfacePtr pendingBackward() const { return pending_backward_; }
 	InterfacePtr pendingForward() const { return pending_forward_; }
 
-	// tags for internal_external_ bimap
-	struct INTERNAL
-	{};
-	struct EXTERNAL
-	{};
-	// map InterfaceStates from children to external InterfaceStates of the container
-	inline const auto& internalToExternalMap() const { return internal_external_.by<INTERNAL>(); }
-	inline const auto& externalToInternalMap() const { return internal_external_.by<EXTERNAL>(); }
+	/** Map InterfaceStates of children (internal) to external InterfaceStates of the container
+	 *
+	 * Links are stored within the states themselves: each internal state refers to (at most) one external state,
+	 * and each external state keeps an intrusive list of its internal states.
+	 */
+	static inline InterfaceState* externalState(const InterfaceState* internal) { return internal->external_; }
+	/// call f(InterfaceState*) for all internal states linked to external
+	template <typename F>
+	static inline void forEachInternalState(const InterfaceState* external, F&& f) {
+		for (InterfaceState* internal = external->first_internal_; internal; internal = internal->next_internal_)
+			f(internal);
+	}
+
+	/** Release planning scenes and trajectories of pruned branches that cannot be re-enabled anymore
+	 *
+	 * A branch (connected via solutions and internal/external links) is dead, if all its states are PRUNED:
+	 * Only ARMED states are re-enabled by new states. States and solutions are kept (and thus their IDs),
+	 * but their scenes and trajectories are released. Considers all states pruned since the last call
+	 * (while collection was enabled), recursively for all child containers. Returns the number of released states.
+	 */
+	std::size_t collectPrunedBranches();
+	/// Connecting stages re-enable PRUNED states if a state of the opposite interface becomes enabled
+	using OppositeInterfaces = std::unordered_map<const Interface*, const Interface*>;
+	/// alive accumulates the states of branches found alive during this pass, which are not traversed again
+	std::size_t collectPrunedBranches(const OppositeInterfaces& opposites,
+	                                  std::unordered_set<const InterfaceState*>& alive);
+
+	/// only record pruned states (for collectPrunedBranches()) if the flag is set
+	void setCollectPrunedMember(const bool* collect_pruned) { collect_pruned_ = collect_pruned; }
+	bool collectingPruned() const { return collect_pruned_ != nullptr && *collect_pruned_; }
 
 	/// called by a (direct) child when a solution failed
 	virtual void onNewFailure(const Stage& child, const InterfaceState* from, const InterfaceState* to);
 
+	/// called by a (direct) child when its BOUNDED interface dropped a state, which arrived in direction dir
+	void onDroppedState(Interface::Direction dir, const InterfaceState* state);
+
+	/** Discard solutions of this container and all its descendants matching the predicate
+	 *
+	 * First, all matching solutions are marked as failures (with the given comment), such that they are not
+	 * considered as alternative paths anymore. Afterwards, their states are pruned via setStatus() like for
+	 * any other failure. Returns the number of discarded solutions.
+	 */
+	std::size_t invalidateSolutions(const std::function<bool(const SolutionBase&)>& predicate,
+	                                const std::string& comment);
+	/// called by invalidateSolutions() for a solution of a (direct) child, which was marked as failure already
+	virtual void onInvalidatedSolution(const Stage& child, const SolutionBase& solution);
+
+	/// replace the (non-released) scenes of all states of this container and its descendants
+	using SceneUpdate =
+	    std::function<planning_scene::PlanningSceneConstPtr(const planning_scene::PlanningSceneConstPtr&)>;
+	void updateScenes(const SceneUpdate& update);
+
 protected:
 	ContainerBasePrivate(ContainerBase* me, const std::string& name);
 	ContainerBasePrivate& operator=(ContainerBasePrivate&& other);
@@ -154,6 +220,9 @@ protected:
 	void setStatus(const Stage* creator, const InterfaceState* source, const InterfaceState* target,
 	               InterfaceState::Status status);
 
+	/// PRUNE states created by the child's (invalidated) solution: they cannot be reached anymore
+	void pruneCreatedStates(const Stage& child, const SolutionBase& solution);
+
 	/// Copy external_state to a child's interface and remember the link in internal_external map
 	template <Interface::Direction>
 	void copyState(Interface::iterator external, const InterfacePtr& target, Interface::UpdateFlags updated);
@@ -165,9 +234,24 @@ protected:
 	void liftSolution(const SolutionBasePtr& solution, const InterfaceState* internal_from,
 	                  const InterfaceState* internal_to);
 
-	/// protected writable overloads
-	inline auto& internalToExternalMap() { return internal_external_.by<INTERNAL>(); }
-	inline auto& externalToInternalMap() { return internal_external_.by<EXTERNAL>(); }
+	/// link internal state (of a child) to external state (of this container)
+	static inline void linkStates(InterfaceState* internal, InterfaceState* external) {
+		assert(internal->external_ == nullptr);
+		internal->external_ = external;
+		internal->next_internal_ = external->first_internal_;
+		external->first_internal_ = internal;
+	}
+	/// remove the link of internal state (of a child) to its external state
+	static inline void unlinkState(InterfaceState* internal) {
+		if (!internal->external_)
+			return;
+		InterfaceState** link = &internal->external_->first_internal_;
+		while (*link != internal)
+			link = &(*link)->next_internal_;
+		*link = internal->next_internal_;
+		internal->external_ = nullptr;
+		internal->next_internal_ = nullptr;
+	}
 
 	// set in resolveInterface()
 	InterfaceFlags required_interface_;
@@ -175,13 +259,11 @@ protected:
 private:
 	container_type children_;
 
-	// map start/end states of children (internal) to corresponding states in our external interfaces
-	boost::bimap<boost::bimaps::unordered_set_of<boost::bimaps::tagged<const InterfaceState*, INTERNAL>>,
-	             boost::bimaps::unordered_multiset_of<boost::bimaps::tagged<const InterfaceState*, EXTERNAL>>>
-	    internal_external_;
+	// states marked PRUNED by setStatus() since the last collectPrunedBranches()
+	std::vector<const InterfaceState*> pruned_states_;
+	const bool* collect_pruned_ = nullptr;
 
-	/* TODO: these interfaces don't need to be priority-sorted.
-	 * Introduce base class UnsortedInterface (which is a plain list) for this use case. */
+	// these interfaces don't need to be priority-sorted: they use FIFO storage
 	// interface to receive children's sendBackward() states
 	InterfacePtr pending_backward_;
 	// interface to receive children's sendForward() states
@@ -215,6 +297,57 @@ protected:
 	// validate that child's interface matches mine (considering start or end only as determined by mask)
 	template <unsigned int mask>
 	void validateInterface(const StagePrivate& child, InterfaceFlags required) const;
+
+	// best partial path priorities of an internal state toward the container's start (BACKWARD) and end (FORWARD)
+	struct PathPriorities
+	{
+		InterfaceState::Priority backward{ 0, 0.0 };
+		InterfaceState::Priority forward{ 0, 0.0 };
+	};
+	const PathPriorities& pathPriorities(const InterfaceState& s) const;
+	// incrementally update path priorities (and state priorities) for a new child solution
+	void updatePathPriorities(const SolutionBase& current);
+	template <Interface::Direction dir>
+	void propagatePathPriority(const InterfaceState& s, const InterfaceState::Priority& prio);
+	// update state priority to its best partial solution path
+	void updateStatePriority(const InterfaceState& s, const PathPriorities& paths);
+
+	// partial solution path, lazily extended toward the container's start and end
+	struct PathCandidate
+	{
+		SolutionSequence::container_type seq;
+		double cost;  // accumulated cost of solutions in seq
+		double key;  // cost plus best costs to reach the container's start and end from seq
+		size_t id;  // creation order, to break ties
+		size_t newest;  // arrival index of the solution seeding the path: only older ones are used for extension
+		size_t missing_before;  // number of solutions still to prepend
+
+		bool operator>(const PathCandidate& other) const {
+			return key != other.key ? key > other.key : id > other.id;
+		}
+	};
+	// seed lazy enumeration of all full solution paths passing through current
+	void addCandidate(const SolutionBase& current, size_t num_before);
+	void pushCandidate(PathCandidate&& candidate);
+	template <Interface::Direction dir>
+	void extendCandidate(const PathCandidate& candidate);
+	// lift the cheapest pending full solution path, returns false if there is none
+	bool liftNextSolution();
+	bool hasCandidates() const { return !candidates_.empty(); }
+	// lower bound for the cost of all pending full solution paths (infinity if there is none)
+	double candidatesCostLowerBound() const {
+		return candidates_.empty() ? std::numeric_limits<double>::infinity() : candidates_.top().key;
+	}
+
+private:
+	// path priorities of internal states, used for incremental assembly only
+	std::unordered_map<const InterfaceState*, PathPriorities> path_priorities_;
+
+	// pending partial solution paths, cheapest first (lazy enumeration only)
+	std::priority_queue<PathCandidate, std::vector<PathCandidate>, std::greater<PathCandidate>> candidates_;
+	size_t num_candidates_ = 0;
+	// arrival order of child solutions (lazy enumeration only)
+	std::unordered_map<const SolutionBase*, size_t> arrival_;
 };
 PIMPL_FUNCTIONS(SerialContainer)
 
@@ -258,6 +391,7 @@ public:
 
 	void initializeExternalInterfaces() final;
 	void onNewFailure(const Stage& child, const InterfaceState* from, const InterfaceState* to) override;
+	void onInvalidatedSolution(const Stage& child, const SolutionBase& solution) override;
 
 	// virtual methods specific to each variant
 	virtual void onNewSolution(const SolutionBase& s);
@@ -298,6 +432,8 @@ struct FallbacksPrivatePropagator : FallbacksPrivateCommon
 	void reset() override;
 	void onNewSolution(const SolutionBase& s) override;
 	bool nextJob() override;
+	// compute the current job with the current and speculatively with subsequent children
+	void compute() override;
 
 	Interface::Direction dir_;  // propagation direction
 	Interface::iterator job_;  // pointer to currently processed external state
@@ -325,6 +461,9 @@ class WrapperBasePrivate : public ParallelContainerBasePrivate
 
 public:
 	WrapperBasePrivate(WrapperBase* me, const std::string& name);
+
+	// a wrapper can run concurrently if its child can
+	bool canComputeConcurrently() const override;
 };
 PIMPL_FUNCTIONS(WrapperBase)
 
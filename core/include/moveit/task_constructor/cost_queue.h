@@ -2,6 +2,9 @@
 
 #include <queue>
 #include <list>
+#include <set>
+#include <unordered_map>
+#include <cassert>
 #include <deque>
 #include <iostream>
 #include <algorithm>
@@ -23,7 +26,10 @@ struct ValueOrPointeeLess<T, decltype(*std::declval<T>() < *std::declval<T>())>
  *
  *  In contrast to std::priority_queue, we use a std::list as the underlying container.
  *  This ensures, that existing iterators remain valid upon insertion and deletion.
- *  Sorted insertion has logarithmic complexity.
+ *
+ *  Small containers locate the sorted position of new or updated items by linear search.
+ *  Once the container reaches indexThreshold() items, it additionally maintains a balanced search tree
+ *  of its list iterators, such that sorted insertion and update have logarithmic complexity.
  */
 template <typename T, typename Compare = ValueOrPointeeLess<T>>
 class ordered
@@ -46,23 +52,98 @@ public:
 	using reverse_iterator = typename container_type::reverse_iterator;
 	using const_reverse_iterator = typename container_type::const_reverse_iterator;
 
+	/// default size from which on items are indexed
+	static constexpr size_type DEFAULT_INDEX_THRESHOLD = 64;
+
 protected:
 	container_type c;
 	Compare comp;
 
+private:
+	// compare list iterators by their items, allowing heterogeneous lookup of items
+	struct IndexCompare
+	{
+		using is_transparent = void;
+		Compare comp;
+
+		bool operator()(const iterator& lhs, const iterator& rhs) const { return comp(*lhs, *rhs); }
+		bool operator()(const value_type& lhs, const iterator& rhs) const { return comp(lhs, *rhs); }
+		bool operator()(const iterator& lhs, const value_type& rhs) const { return comp(*lhs, rhs); }
+	};
+	using index_type = std::multiset<iterator, IndexCompare>;
+
+	// search tree of all list items (if indexed()), ordered like c
+	index_type index_;
+	// map item address to its index node: items might have changed their value before update()
+	std::unordered_map<const value_type*, typename index_type::iterator> index_handles_;
+	bool indexed_ = false;
+	size_type index_threshold_ = DEFAULT_INDEX_THRESHOLD;
+
 public:
 	/// initialize empty container
-	explicit ordered() {}
+	explicit ordered(const Compare& compare = Compare()) : comp(compare), index_(IndexCompare{ compare }) {}
+	ordered(const ordered& other)
+	  : c(other.c), comp(other.comp), index_(IndexCompare{ other.comp }), index_threshold_(other.index_threshold_) {
+		if (other.indexed_)
+			buildIndex();
+	}
+	// list nodes, and thus iterators, are transferred: the index stays valid
+	ordered(ordered&& other)
+	  : c(std::move(other.c))
+	  , comp(other.comp)
+	  , index_(std::move(other.index_))
+	  , index_handles_(std::move(other.index_handles_))
+	  , indexed_(other.indexed_)
+	  , index_threshold_(other.index_threshold_) {
+		other.clear();  // leave other empty and unindexed
+	}
+	ordered& operator=(const ordered& other) {
+		if (this != &other) {
+			c = other.c;
+			comp = other.comp;
+			index_threshold_ = other.index_threshold_;
+			dropIndex();
+			index_ = index_type(IndexCompare{ comp });
+			if (other.indexed_)
+				buildIndex();
+		}
+		return *this;
+	}
+	ordered& operator=(ordered&& other) {
+		if (this != &other) {
+			c = std::move(other.c);
+			comp = other.comp;
+			index_ = std::move(other.index_);
+			index_handles_ = std::move(other.index_handles_);
+			indexed_ = other.indexed_;
+			index_threshold_ = other.index_threshold_;
+			other.clear();  // leave other empty and unindexed
+		}
+		return *this;
+	}
 
 	bool empty() const { return c.empty(); }
 	size_type size() const { return c.size(); }
 
-	void clear() { c.clear(); }
+	void clear() {
+		dropIndex();
+		c.clear();
+	}
+
+	/// size from which on sorted insertion uses a search tree (0: always)
+	size_type indexThreshold() const { return index_threshold_; }
+	void setIndexThreshold(size_type threshold) {
+		index_threshold_ = threshold;
+		if (!indexed_ && size() >= index_threshold_)
+			buildIndex();
+	}
+	bool indexed() const { return indexed_; }
 
 	reference top() { return c.front(); }
 	const_reference top() const { return c.front(); }
 	value_type pop() {
 		value_type result(top());
+		unindex(c.begin());
 		c.pop_front();
 		return result;
 	}
@@ -86,45 +167,104 @@ public:
 	const_reverse_iterator crend() const { return c.rend(); }
 
 	/// explicitly sort container, useful if many items have changed their value
-	void sort() { c.sort(comp); }
+	void sort() {
+		c.sort(comp);
+		if (indexed_)
+			buildIndex();
+	}
 
 	iterator insert(const value_type& item) {
-		iterator at = std::upper_bound(c.begin(), c.end(), item, comp);
-		return c.insert(at, item);
+		container_type temp;
+		temp.push_back(item);
+		return moveFrom(temp.begin(), temp);
 	}
 	iterator insert(value_type&& item) {
-		iterator at = std::upper_bound(c.begin(), c.end(), item, comp);
-		return c.insert(at, std::move(item));
+		container_type temp;
+		temp.push_back(std::move(item));
+		return moveFrom(temp.begin(), temp);
 	}
 	inline void push(const value_type& item) { insert(item); }
 	inline void push(value_type&& item) { insert(std::move(item)); }
 
-	iterator erase(const_iterator pos) { return c.erase(pos); }
+	iterator erase(const_iterator pos) {
+		unindex(pos);
+		return c.erase(pos);
+	}
 
 	/// update sort position of a single item after changes
 	iterator update(iterator& it) {
 		container_type temp;
-		temp.splice(temp.end(), c, it);  // move it from c to temp
-		iterator at = std::upper_bound(c.begin(), c.end(), *it, comp);
-		c.splice(at, temp, it);
-		return it;
+		moveTo(it, temp, temp.end());  // move it from c to temp
+		return moveFrom(it, temp);
 	}
 
 	/// move element pos from this to other container, inserting before other_pos
 	iterator moveTo(iterator pos, container_type& other, iterator other_pos) {
+		unindex(pos);
 		other.splice(other_pos, c, pos);
 		return pos;
 	}
 	/// move element pos from other container into this one (sorted)
 	iterator moveFrom(iterator pos, container_type& other) {
-		iterator at = std::upper_bound(begin(), end(), *pos, comp);
-		c.splice(at, other, pos);
+		if (!indexed_) {
+			iterator at = std::upper_bound(begin(), end(), *pos, comp);
+			c.splice(at, other, pos);
+			if (size() >= index_threshold_)
+				buildIndex();
+			return pos;
+		}
+		auto index_at = index_.upper_bound(*pos);
+		c.splice(index_at == index_.end() ? c.end() : *index_at, other, pos);
+		// hinted insertion places the new node right before index_at, i.e. behind equal items
+		index_handles_[&*pos] = index_.insert(index_at, pos);
 		return pos;
 	}
 
 	template <typename Predicate>
 	void remove_if(Predicate p) {
-		c.remove_if(p);
+		if (!indexed_) {
+			c.remove_if(p);
+			return;
+		}
+		for (iterator it = c.begin(); it != c.end();) {
+			if (p(*it))
+				it = erase(it);
+			else
+				++it;
+		}
+	}
+
+protected:
+	/// change the sort criterion (of a stateful Compare), resorting all items
+	void setCompare(const Compare& compare) {
+		comp = compare;
+		dropIndex();
+		index_ = index_type(IndexCompare{ comp });
+		c.sort(comp);  // stable: items considered equal keep their order
+		if (size() >= index_threshold_)
+			buildIndex();
+	}
+
+private:
+	void buildIndex() {
+		dropIndex();
+		index_handles_.reserve(c.size());
+		for (iterator it = c.begin(); it != c.end(); ++it)
+			index_handles_[&*it] = index_.insert(index_.end(), it);
+		indexed_ = true;
+	}
+	void dropIndex() {
+		index_.clear();
+		index_handles_.clear();
+		indexed_ = false;
+	}
+	void unindex(const_iterator pos) {
+		if (!indexed_)
+			return;
+		auto handle = index_handles_.find(&*pos);
+		assert(handle != index_handles_.end());
+		index_.erase(handle->second);
+		index_handles_.erase(handle);
 	}
 };
 
@@ -80,14 +80,38 @@ public:
 	/// fill task state message for publishing the current task state
 	moveit_task_constructor_msgs::msg::TaskStatistics&
 	fillTaskStatistics(moveit_task_constructor_msgs::msg::TaskStatistics& msg);
+	/// fill next task state message to publish: a full snapshot or an incremental update (see setIncrementalStatistics)
+	moveit_task_constructor_msgs::msg::TaskStatistics&
+	fillTaskState(moveit_task_constructor_msgs::msg::TaskStatistics& msg);
 	/// publish the current state of task
 	void publishTaskState();
 
 	/// indicate that this task was reset
 	void reset();
 
+	/// include extended stage telemetry in published task statistics (disabled by default)
+	void setPublishTelemetry(bool enable);
+	bool publishTelemetry() const;
+
+	/** send properties having a binary form (ROS messages) in binary form only, omitting their YAML text
+	 *
+	 * Disabled by default: rviz can decode binary values of message types only if their type support is installed.
+	 */
+	void setBinaryOnlyProperties(bool enable);
+	bool binaryOnlyProperties() const;
+
+	/** publish task statistics incrementally (disabled by default)
+	 *
+	 * Incremental messages only list solutions added since the previous message.
+	 * Every full_snapshot_period-th message is a full snapshot to allow late subscribers to catch up.
+	 */
+	void setIncrementalStatistics(bool enable, unsigned int full_snapshot_period = 100);
+	bool incrementalStatistics() const;
+
 	/// register the given solution, assigning a unique ID
 	void registerSolution(const SolutionBase& s);
+	/// record a solution (or failure) newly stored by its creator stage for incremental statistics
+	void recordSolution(const SolutionBase& s, bool failed);
 
 	/// publish the given solution
 	void publishSolution(const SolutionBase& s);
@@ -107,6 +131,11 @@ public:
 
 private:
 	void fillStageStatistics(const Stage& stage, moveit_task_constructor_msgs::msg::StageStatistics& s);
+	/// fill incremental stage statistics, returning false if stage didn't change since previous message
+	bool fillStageStatisticsDelta(const Stage& stage, moveit_task_constructor_msgs::msg::StageStatistics& s);
+	moveit_task_constructor_msgs::msg::TaskStatistics&
+	fillTaskStatisticsDelta(moveit_task_constructor_msgs::msg::TaskStatistics& msg);
+	void fillStageTelemetry(const Stage& stage, moveit_task_constructor_msgs::msg::StageTelemetry& t);
 	void fillSolution(moveit_task_constructor_msgs::msg::Solution& msg, const SolutionBase& s);
 	/// retrieve or set id of given stage
 	uint32_t stageId(const moveit::task_constructor::Stage* const s);
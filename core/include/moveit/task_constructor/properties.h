@@ -40,7 +40,12 @@
 
 #include <boost/any.hpp>
 #include <typeindex>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include <functional>
@@ -103,19 +108,28 @@ public:
 	void reset();
 
 	/// the current value defined or will the fallback be used?
-	inline bool defined() const { return !value_.empty(); }
+	inline bool defined() const { return value_ != nullptr; }
 
 	/// get current value (or default if not defined)
-	inline const boost::any& value() const { return value_.empty() ? default_ : value_; }
-	inline boost::any& value() { return value_.empty() ? default_ : value_; }
+	inline const boost::any& value() const { return value_ ? *value_ : defaultValue(); }
+	/// get mutable access to current value, which is considered a modification
+	boost::any& value();
 	/// get default value
-	const boost::any& defaultValue() const { return default_; }
+	inline const boost::any& defaultValue() const { return default_ ? *default_ : EMPTY; }
 
 	/// serialize value using registered functions
 	static std::string serialize(const boost::any& value);
 	static boost::any deserialize(const std::string& type_name, const std::string& wire);
 	std::string serialize() const { return serialize(value()); }
 
+	/// binary serialization using registered functions: CDR for ROS messages, empty for other types
+	static std::vector<uint8_t> serializeBinary(const boost::any& value);
+	static boost::any deserializeBinary(const std::string& type_name, const std::vector<uint8_t>& wire);
+	std::vector<uint8_t> serializeBinary() const { return serializeBinary(value()); }
+
+	/// serialize value for transmission: as text, and in binary form if available (skipping text if binary_only)
+	void serialize(std::string& text, std::vector<uint8_t>& binary, bool binary_only = false) const;
+
 	/// get description text
 	const std::string& description() const { return description_; }
 	void setDescription(const std::string& desc) { description_ = desc; }
@@ -131,16 +145,52 @@ public:
 	/// configure initialization from source using given other property name
 	Property& configureInitFrom(SourceFlags source, const std::string& name);
 
+	/// version stamp, globally unique and increasing with every modification
+	uint64_t version() const { return version_; }
+
 private:
+	/// values are shared between copies of a Property until modified
+	using Value = std::shared_ptr<boost::any>;
+	static const boost::any EMPTY;
+
+	/// assign a new version stamp
+	void touch();
+	/// throw type_error if value doesn't match the declared type
+	void checkType(const boost::any& value) const;
+	/// current (or default) value for sharing with another Property, nullptr if undefined
+	Value sharedValue() const;
+	/// set current value and default value, sharing the given value
+	void shareValue(const Value& value);
+	/// set current value, sharing the given value
+	void shareCurrentValue(const Value& value);
+	/// take over everything from other, which must have the same declared type
+	void assign(const Property& other);
+
 	std::string description_;
 	const type_info& type_info_;
-	boost::any default_;
-	boost::any value_;
+	Value default_;
+	Value value_;  // nullptr if undefined
 
 	/// used for external initialization
 	SourceFlags source_flags_ = 0;
 	SourceFlags initialized_from_;
 	InitializerFunction initializer_;
+	/// name of the source property, if initialized by name
+	std::string init_name_;
+
+	/// (source map id, source property version, own version) of last initialization by name
+	struct InitStamp
+	{
+		uint64_t map_id = 0;
+		uint64_t source_version = 0;
+		uint64_t version = 0;
+		bool operator==(const InitStamp& other) const {
+			return map_id == other.map_id && source_version == other.source_version && version == other.version;
+		}
+	};
+	InitStamp init_stamp_;
+
+	uint64_t version_;
 };
 
 class Property::error : public std::runtime_error
@@ -194,13 +244,19 @@ class PropertySerializerBase
 public:
 	using SerializeFunction = std::string (*)(const boost::any&);
 	using DeserializeFunction = boost::any (*)(const std::string&);
+	using BinarySerializeFunction = std::vector<uint8_t> (*)(const boost::any&);
+	using BinaryDeserializeFunction = boost::any (*)(const std::vector<uint8_t>&);
 
 	static std::string dummySerialize(const boost::any& /*unused*/) { return ""; }
 	static boost::any dummyDeserialize(const std::string& /*unused*/) { return boost::any(); }
+	static std::vector<uint8_t> dummySerializeBinary(const boost::any& /*unused*/) { return {}; }
+	static boost::any dummyDeserializeBinary(const std::vector<uint8_t>& /*unused*/) { return boost::any(); }
 
 protected:
+	/// register (de)serialization functions
 	static bool insert(const std::type_index& type_index, const std::string& type_name, SerializeFunction serialize,
-	                   DeserializeFunction deserialize);
+	                   DeserializeFunction deserialize, BinarySerializeFunction serialize_binary,
+	                   BinaryDeserializeFunction deserialize_binary);
 };
 
 /// utility class to register serializer/deserializer functions for a property of type T
@@ -208,7 +264,9 @@ template <typename T>
 class PropertySerializer : protected PropertySerializerBase
 {
 public:
-	PropertySerializer() { insert(typeid(T), typeName<T>(), &serialize, &deserialize); }
+	PropertySerializer() {
+		insert(typeid(T), typeName<T>(), &serialize, &deserialize, &serializeBinary, &deserializeBinary);
+	}
 
 	template <class Q = T>
 	static typename std::enable_if<rosidl_generator_traits::is_message<Q>::value, std::string>::type typeName() {
@@ -247,6 +305,97 @@ private:
 	deserialize(const std::string& wire) {
 		return dummyDeserialize(wire);
 	}
+
+	/** Binary serialization of ROS messages based on rclcpp::Serialization (CDR) */
+	template <class Q = T>
+	static typename std::enable_if<rosidl_generator_traits::is_message<Q>::value, std::vector<uint8_t>>::type
+	serializeBinary(const boost::any& value) {
+		static const rclcpp::Serialization<T> SERIALIZER;
+		rclcpp::SerializedMessage msg;
+		SERIALIZER.serialize_message(&boost::any_cast<const T&>(value), &msg);
+		const auto& raw = msg.get_rcl_serialized_message();
+		return std::vector<uint8_t>(raw.buffer, raw.buffer + raw.buffer_length);
+	}
+	template <class Q = T>
+	static typename std::enable_if<rosidl_generator_traits::is_message<Q>::value, boost::any>::type
+	deserializeBinary(const std::vector<uint8_t>& wire) {
+		static const rclcpp::Serialization<T> SERIALIZER;
+		rclcpp::SerializedMessage msg(wire.size());
+		auto& raw = msg.get_rcl_serialized_message();
+		std::memcpy(raw.buffer, wire.data(), wire.size());
+		raw.buffer_length = wire.size();
+		T value;
+		SERIALIZER.deserialize_message(&msg, &value);
+		return value;
+	}
+
+	/** No binary serialization available */
+	template <class Q = T>
+	static typename std::enable_if<!rosidl_generator_traits::is_message<Q>::value, std::vector<uint8_t>>::type
+	serializeBinary(const boost::any& value) {
+		return dummySerializeBinary(value);
+	}
+	template <class Q = T>
+	static typename std::enable_if<!rosidl_generator_traits::is_message<Q>::value, boost::any>::type
+	deserializeBinary(const std::vector<uint8_t>& wire) {
+		return dummyDeserializeBinary(wire);
+	}
+};
+
+/** Typed handle to a declared Property, providing fast access to its value
+ *
+ * A handle is resolved once via PropertyMap::handle<T>(), e.g. in init(),
+ * checking the declared type. Accessing the value doesn't require a name lookup nor a type check anymore.
+ * The handle remains valid as long as its PropertyMap isn't destroyed. Assigning another map keeps the handle
+ * valid if the other map declares the property with the same type, too.
+ */
+template <typename T>
+class PropertyHandle
+{
+	friend class PropertyMap;
+	PropertyHandle(const std::string& name, const Property& property) : name_(&name), property_(&property) {}
+
+public:
+	PropertyHandle() = default;
+
+	/// was the handle resolved?
+	bool valid() const { return property_ != nullptr; }
+	const std::string& name() const {
+		static const std::string UNBOUND;
+		return name_ ? *name_ : UNBOUND;
+	}
+
+	/// Get typed value of property. Throws undefined, or undeclared if the handle wasn't resolved.
+	const T& get() const {
+		const boost::any& value = this->value();
+		if (value.empty())
+			throw Property::undefined(*name_);
+		return cast(value);
+	}
+	/// get typed value of property, using fallback if undefined
+	const T& get(const T& fallback) const {
+		const boost::any& value = this->value();
+		return value.empty() ? fallback : cast(value);
+	}
+
+private:
+	const boost::any& value() const {
+		assert(valid());
+		if (!valid())  // e.g. accessed before init()
+			throw Property::undeclared("", "property handle was not resolved");
+		return property_->value();
+	}
+
+	// type was checked in PropertyMap::handle(), a property declared as boost::any holds an arbitrary type
+	static const T& cast(const boost::any& value) {
+		if constexpr (std::is_same<T, boost::any>::value)
+			return value;
+		else
+			return *boost::unsafe_any_cast<T>(&value);
+	}
+
+	const std::string* name_ = nullptr;
+	const Property* property_ = nullptr;
 };
 
 /** PropertyMap is map of (name, Property) pairs.
@@ -256,13 +405,42 @@ private:
  */
 class PropertyMap
 {
-	std::map<std::string, Property> props_;
+	using Map = std::map<std::string, Property>;
+	/// properties are shared between copies of a PropertyMap until modified (copy-on-write)
+	std::shared_ptr<Map> props_;
+	/// handles refer into props_, which thus must not be shared anymore
+	bool pinned_ = false;
+
+	/// unique id of this map instance, renewed on assignment
+	uint64_t id_;
+	/// (source, other id, other version, own version) of last performInitFrom()
+	struct InitStamp
+	{
+		Property::SourceFlags source = 0;
+		uint64_t other_id = 0;
+		uint64_t other_version = 0;
+		uint64_t version = 0;
+	};
+	InitStamp last_init_;
+
+	/// access props_ for modification, unsharing them if needed
+	Map& writable();
+	/// access props_ for handing out references, which thus must not be shared anymore
+	Map& pin();
+	/// copy other's properties into the pinned storage, keeping existing entries (and their handles) in place
+	void assignPinned(const Map& other);
 
 	/// implementation of declare methods
 	Property& declare(const std::string& name, const Property::type_info& type_info, const std::string& description,
 	                  const boost::any& default_value);
 
 public:
+	PropertyMap();
+	PropertyMap(const PropertyMap& other);
+	PropertyMap(PropertyMap&& other);
+	PropertyMap& operator=(const PropertyMap& other);
+	PropertyMap& operator=(PropertyMap&& other);
+
 	/// declare a property for future use
 	template <typename T>
 	Property& declare(const std::string& name, const std::string& description = "") {
@@ -285,17 +463,20 @@ public:
 	/// check whether given property is declared
 	bool hasProperty(const std::string& name) const;
 
-	/// get the property with given name, throws Property::undeclared for unknown name
+	/** get the property with given name, throws Property::undeclared for unknown name
+	 *
+	 * The non-const version pins the map's storage, i.e. copies of the map won't share it anymore.
+	 */
 	Property& property(const std::string& name);
-	const Property& property(const std::string& name) const { return const_cast<PropertyMap*>(this)->property(name); }
+	const Property& property(const std::string& name) const;
 
-	using iterator = std::map<std::string, Property>::iterator;
-	using const_iterator = std::map<std::string, Property>::const_iterator;
+	using iterator = Map::iterator;
+	using const_iterator = Map::const_iterator;
 
-	iterator begin() { return props_.begin(); }
-	iterator end() { return props_.end(); }
-	const_iterator begin() const { return props_.begin(); }
-	const_iterator end() const { return props_.end(); }
+	iterator begin() { return pin().begin(); }
+	iterator end() { return pin().end(); }
+	const_iterator begin() const { return props_->begin(); }
+	const_iterator end() const { return props_->end(); }
 
 	/// allow initialization from given source for listed properties - always using the same name
 	void configureInitFrom(Property::SourceFlags source, const std::set<std::string>& properties = {});
@@ -303,8 +484,9 @@ public:
 	/// set (and, if neccessary, declare) the value of a property
 	template <typename T>
 	void set(const std::string& name, const T& value) {
-		auto it = props_.find(name);
-		if (it == props_.end())  // name is not yet declared
+		Map& props = writable();
+		auto it = props.find(name);
+		if (it == props.end())  // name is not yet declared
 			declare<T>(name, value, "");
 		else
 			it->second.setValue(value);
@@ -313,6 +495,9 @@ public:
 	/// overloading: const char* is stored as std::string
 	inline void set(const std::string& name, const char* value) { set<std::string>(name, value); }
 
+	/// set (and, if neccessary, declare) a property to the value of source, sharing the value without copying
+	void setFrom(const std::string& name, const Property& source);
+
 	/// temporarily set the value of a property
 	void setCurrent(const std::string& name, const boost::any& value);
 
@@ -334,13 +519,36 @@ public:
 		return (value.empty()) ? fallback : boost::any_cast<const T&>(value);
 	}
 
+	/** Get a typed handle to a property. Throws undeclared, or type_error if T doesn't match the declared type.
+	 *
+	 * The map's storage becomes pinned, i.e. copies of the map won't share it anymore.
+	 */
+	template <typename T>
+	PropertyHandle<T> handle(const std::string& name) {
+		Map& props = pin();
+		auto it = props.find(name);
+		if (it == props.end())
+			throw Property::undeclared(name);
+		if (it->second.type_info_ != typeid(T))
+			throw Property::type_error(typeid(T).name(), it->second.type_info_.name());
+		return PropertyHandle<T>(it->first, it->second);
+	}
+
 	/// count number of defined properties from given list
 	size_t countDefined(const std::vector<std::string>& list) const;
 
 	/// reset all properties to their defaults
 	void reset();
 
-	/// perform initialization of still undefined properties using configured initializers
+	/// version of the map's content, increasing with every modification of any of its properties
+	uint64_t version() const;
+
+	/** perform initialization of still undefined properties using configured initializers
+	 *
+	 * Initialization is incremental: If neither this map nor other were modified since the last call
+	 * (from the same source), the call is skipped entirely. Properties initialized by name are only updated
+	 * if their source property changed. Initializer functions are assumed to only depend on other.
+	 */
 	void performInitFrom(Property::SourceFlags source, const PropertyMap& other);
 };
 
@@ -0,0 +1,138 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:    Policies to schedule the computation of a container's children
+*/
+
+#pragma once
+
+#include <moveit/task_constructor/storage.h>
+#include <moveit/macros/class_forward.hpp>
+
+#include <vector>
+
+namespace moveit {
+namespace task_constructor {
+
+MOVEIT_CLASS_FORWARD(Stage);
+MOVEIT_CLASS_FORWARD(SchedulerPolicy);
+
+/// Information about a child stage ready to compute, used by a SchedulerPolicy to rank the child
+struct SchedulingCandidate
+{
+	SchedulingCandidate(const Stage& stage);
+
+	const Stage* stage;
+	/// priority (depth, cost) of the most promising state (pair) pending for computation,
+	/// StagePrivate::noPendingPriority() if there is none (e.g. for generators)
+	InterfaceState::Priority priority;
+	/// number of solutions and failures found so far
+	std::size_t num_solutions;
+	std::size_t num_failures;
+	/// number of compute() calls and their accumulated duration (s)
+	std::size_t num_computes;
+	double compute_time;
+
+	/// fraction of successful results (Laplace-smoothed to rate unexplored stages as 0.5)
+	double successRate() const { return (num_solutions + 1.0) / (num_solutions + num_failures + 2.0); }
+	/// average duration of a compute() call, 0 if not yet computed
+	double meanComputeTime() const { return num_computes ? compute_time / num_computes : 0.0; }
+	/// expected compute time required to find a new solution
+	double expectedCost() const { return meanComputeTime() / successRate(); }
+};
+
+/** A SchedulerPolicy decides which children of a container are computed in the next step of the container.
+ *
+ * By default, i.e. without any policy, all children able to compute are computed once per step (round robin).
+ * A policy is configured via ContainerBase::setSchedulerPolicy() and inherited by nested containers.
+ */
+class SchedulerPolicy
+{
+public:
+	using Candidates = std::vector<SchedulingCandidate>;
+
+	virtual ~SchedulerPolicy() = default;
+
+	/** Select the children to compute next.
+	 *
+	 * @param candidates all children ready to compute, in their original order.
+	 * Remove or reorder entries: the remaining children are computed in the given order.
+	 */
+	virtual void schedule(Candidates& candidates) const = 0;
+};
+
+/// Compute all candidates once per step (the default behavior)
+class RoundRobinScheduler : public SchedulerPolicy
+{
+public:
+	void schedule(Candidates& /*candidates*/) const override {}
+};
+
+/// Base class for best-first policies, computing the max_stages best candidates w.r.t. a ranking
+class BestFirstScheduler : public SchedulerPolicy
+{
+public:
+	explicit BestFirstScheduler(std::size_t max_stages = 1) : max_stages_(max_stages) {}
+
+	void schedule(Candidates& candidates) const override;
+
+protected:
+	/// should candidate a be computed before b?
+	virtual bool better(const SchedulingCandidate& a, const SchedulingCandidate& b) const = 0;
+
+private:
+	std::size_t max_stages_;
+};
+
+/// Prefer stages working on the deepest (then cheapest) partial solutions, i.e. the ones closest to a full solution
+class DeepestFirstScheduler : public BestFirstScheduler
+{
+public:
+	using BestFirstScheduler::BestFirstScheduler;
+
+protected:
+	bool better(const SchedulingCandidate& a, const SchedulingCandidate& b) const override;
+};
+
+/// Prefer stages with the smallest expected compute time to find a solution, based on their past performance
+class CheapestExpectedCostScheduler : public BestFirstScheduler
+{
+public:
+	using BestFirstScheduler::BestFirstScheduler;
+
+protected:
+	bool better(const SchedulingCandidate& a, const SchedulingCandidate& b) const override;
+};
+}  // namespace task_constructor
+}  // namespace moveit
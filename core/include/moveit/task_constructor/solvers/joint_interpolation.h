@@ -57,6 +57,7 @@ public:
 	JointInterpolationPlanner();
 
 	void init(const moveit::core::RobotModelConstPtr& robot_model) override;
+	PlannerInterfacePtr clone() const override;
 
 	Result plan(const planning_scene::PlanningSceneConstPtr& from, const planning_scene::PlanningSceneConstPtr& to,
 	            const core::JointModelGroup* jmg, double timeout, robot_trajectory::RobotTrajectoryPtr& result,
@@ -62,6 +62,7 @@ public:
 	using PlannerList::PlannerList;  // inherit all std::vector constructors
 
 	void init(const moveit::core::RobotModelConstPtr& robot_model) override;
+	PlannerInterfacePtr clone() const override;
 
 	Result plan(const planning_scene::PlanningSceneConstPtr& from, const planning_scene::PlanningSceneConstPtr& to,
 	            const moveit::core::JointModelGroup* jmg, double timeout, robot_trajectory::RobotTrajectoryPtr& result,
@@ -42,9 +42,13 @@
 #include <moveit/planning_pipeline_interfaces/planning_pipeline_interfaces.hpp>
 #include <moveit/planning_pipeline_interfaces/solution_selection_functions.hpp>
 #include <moveit/planning_pipeline_interfaces/stopping_criterion_functions.hpp>
+#include <moveit_msgs/msg/workspace_parameters.hpp>
 #include <rclcpp/node.hpp>
 #include <moveit/macros/class_forward.hpp>
 
+#include <set>
+#include <mutex>
+
 namespace planning_pipeline {
 MOVEIT_CLASS_FORWARD(PlanningPipeline);
 }
@@ -106,6 +110,21 @@ public:
 	 */
 	void init(const moveit::core::RobotModelConstPtr& robot_model) override;
 
+	/** \brief Create a new PipelinePlanner with the same configuration, sharing the planning pipelines
+	 *
+	 * Planning pipelines are created only once for the original planner and all its clones. Pipelines serve
+	 * concurrent requests, thus clones can plan in parallel. Only the planner's properties are copied, allowing
+	 * the clone to be configured independently. Pipelines additionally configured for a clone are created
+	 * (and shared as well) by its init().
+	 * \return PipelinePlanner that needs to be initialized via init()
+	 */
+	PlannerInterfacePtr clone() const override;
+
+	/** \brief Planning pipelines created by init(), shared with all clones */
+	const std::unordered_map<std::string, planning_pipeline::PlanningPipelinePtr>& planningPipelines() const {
+		return planning_pipelines_;
+	}
+
 	/** \brief Plan a trajectory from a planning scene 'from' to scene 'to'
 	 * \param [in] from Start planning scene
 	 * \param [in] to Goal planning scene (used to create goal constraints)
@@ -137,7 +156,7 @@ public:
 	            robot_trajectory::RobotTrajectoryPtr& result,
 	            const moveit_msgs::msg::Constraints& path_constraints = moveit_msgs::msg::Constraints()) override;
 
-	std::string getPlannerId() const override { return last_successful_planner_; }
+	std::string getPlannerId() const override;
 
 protected:
 	/** \brief Actual plan() implementation, targeting the given goal_constraints.
@@ -155,15 +174,38 @@ protected:
 	            robot_trajectory::RobotTrajectoryPtr& result,
 	            const moveit_msgs::msg::Constraints& path_constraints = moveit_msgs::msg::Constraints());
 
+	void setLastSuccessfulPlanner(const std::string& planner_id);
+
 	rclcpp::Node::SharedPtr node_;
 
+	// a planner might be used by several stages planning concurrently
+	mutable std::mutex last_successful_planner_mutex_;
 	std::string last_successful_planner_;
 
 	/** \brief Map of instantiated (and named) planning pipelines. */
 	std::unordered_map<std::string, planning_pipeline::PlanningPipelinePtr> planning_pipelines_;
+	/** \brief Pipelines shared between this planner and its clones, created on demand by init() */
+	struct SharedPipelines
+	{
+		std::mutex mutex;  // guards creation of pipelines
+		std::unordered_map<std::string, planning_pipeline::PlanningPipelinePtr> pipelines;
+		// names of pipelines tried to create (also failed ones, which are not retried)
+		std::set<std::string> requested;
+	};
+	std::shared_ptr<SharedPipelines> shared_pipelines_;
 
 	moveit::planning_pipeline_interfaces::StoppingCriterionFunction stopping_criterion_callback_;
 	moveit::planning_pipeline_interfaces::SolutionSelectionFunction solution_selection_function_;
+
+	// handles to properties accessed for each planning request, resolved in init()
+	PropertyHandle<std::unordered_map<std::string, std::string>> pipeline_id_planner_id_map_;
+	PropertyHandle<uint> num_planning_attempts_;
+	PropertyHandle<double> max_velocity_scaling_factor_;
+	PropertyHandle<double> max_acceleration_scaling_factor_;
+	PropertyHandle<moveit_msgs::msg::WorkspaceParameters> workspace_parameters_;
+	PropertyHandle<double> goal_joint_tolerance_;
+	PropertyHandle<double> goal_position_tolerance_;
+	PropertyHandle<double> goal_orientation_tolerance_;
 };
 }  // namespace solvers
 }  // namespace task_constructor
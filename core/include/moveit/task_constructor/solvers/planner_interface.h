@@ -43,6 +43,12 @@
 #include <moveit/task_constructor/properties.h>
 #include <Eigen/Geometry>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
 namespace planning_scene {
 MOVEIT_CLASS_FORWARD(PlanningScene);
 }
@@ -62,10 +68,11 @@ MOVEIT_CLASS_FORWARD(JointModelGroup);
 
 namespace moveit {
 namespace task_constructor {
+class ThreadPool;
 namespace solvers {
 
 MOVEIT_CLASS_FORWARD(PlannerInterface);
-class PlannerInterface
+class PlannerInterface : public std::enable_shared_from_this<PlannerInterface>
 {
 	// these properties take precedence over stage properties
 	PropertyMap properties_;
@@ -79,6 +86,53 @@ public:
 		operator bool() const { return success; }
 	};
 
+	/// Result of an asynchronous planning request
+	struct AsyncResult
+	{
+		Result result;
+		robot_trajectory::RobotTrajectoryPtr trajectory;
+	};
+
+	/** Handle to an asynchronous planning request, see planAsync()
+	 *
+	 * Waiting for a request, which wasn't started by the thread pool yet, runs it in the waiting thread.
+	 * Hence, waiting from within a job of the same pool cannot deadlock, even if all workers are busy.
+	 */
+	class Future
+	{
+	public:
+		Future() = default;
+		Future(std::shared_future<AsyncResult> future, std::shared_ptr<std::atomic<bool>> cancelled,
+		       std::shared_ptr<std::function<void()>> run = nullptr)
+		  : future_(std::move(future)), cancelled_(std::move(cancelled)), run_(std::move(run)) {}
+
+		bool valid() const { return future_.valid(); }
+		/// is the result available (without blocking)?
+		bool ready() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+		/// block until the result is available
+		void wait() const {
+			if (run_)
+				(*run_)();  // no-op if already started
+			future_.wait();
+		}
+		const AsyncResult& get() const {
+			wait();
+			return future_.get();
+		}
+
+		/// Cancel the request. Requests not yet started are skipped, running ones finish normally.
+		void cancel() {
+			if (cancelled_)
+				*cancelled_ = true;
+		}
+		bool cancelled() const { return cancelled_ && *cancelled_; }
+
+	private:
+		std::shared_future<AsyncResult> future_;
+		std::shared_ptr<std::atomic<bool>> cancelled_;
+		std::shared_ptr<std::function<void()>> run_;
+	};
+
 	PlannerInterface();
 	virtual ~PlannerInterface() {}
 
@@ -95,6 +149,11 @@ public:
 
 	virtual void init(const moveit::core::RobotModelConstPtr& robot_model) = 0;
 
+	/** Create an independent copy of this planner, sharing its configuration (properties) but not its
+	 * planning context. Clones can serve planning requests concurrently to the original planner.
+	 * Returns nullptr if the planner doesn't support cloning. */
+	virtual PlannerInterfacePtr clone() const { return nullptr; }
+
 	/// plan trajectory between to robot states
 	virtual Result plan(const planning_scene::PlanningSceneConstPtr& from,
 	                    const planning_scene::PlanningSceneConstPtr& to, const moveit::core::JointModelGroup* jmg,
@@ -108,8 +167,34 @@ public:
 	                    robot_trajectory::RobotTrajectoryPtr& result,
 	                    const moveit_msgs::msg::Constraints& path_constraints = moveit_msgs::msg::Constraints()) = 0;
 
+	/** Plan trajectory between two robot states asynchronously.
+	 *
+	 * The default implementation runs plan() on the given thread pool (usually the task's one, see
+	 * Task::setNumThreads()), serializing the requests to the same planner instance.
+	 * Without a pool, or if the planner is not owned by a shared_ptr, plan() is called synchronously. */
+	virtual Future planAsync(ThreadPool* pool, const planning_scene::PlanningSceneConstPtr& from,
+	                         const planning_scene::PlanningSceneConstPtr& to, const moveit::core::JointModelGroup* jmg,
+	                         double timeout,
+	                         const moveit_msgs::msg::Constraints& path_constraints = moveit_msgs::msg::Constraints());
+
+	/// plan trajectory to Cartesian target asynchronously
+	virtual Future planAsync(ThreadPool* pool, const planning_scene::PlanningSceneConstPtr& from,
+	                         const moveit::core::LinkModel& link,
+	                         const Eigen::Isometry3d& offset, const Eigen::Isometry3d& target,
+	                         const moveit::core::JointModelGroup* jmg, double timeout,
+	                         const moveit_msgs::msg::Constraints& path_constraints = moveit_msgs::msg::Constraints());
+
 	// get name of the planner
 	virtual std::string getPlannerId() const = 0;
+
+protected:
+	using PlanFunction = std::function<Result(PlannerInterface&, robot_trajectory::RobotTrajectoryPtr&)>;
+	/// run given planning function asynchronously on the given thread pool
+	Future runAsync(ThreadPool* pool, PlanFunction&& plan);
+
+private:
+	// serialize asynchronous requests
+	std::mutex plan_mutex_;
 };
 }  // namespace solvers
 }  // namespace task_constructor
@@ -43,6 +43,7 @@
 #include "utils.h"
 #include <moveit/macros/class_forward.hpp>
 #include <moveit/task_constructor/storage.h>
+#include <moveit/task_constructor/arena.h>
 #include <vector>
 #include <list>
 
@@ -143,6 +144,7 @@ MOVEIT_CLASS_FORWARD(CostTerm);
 class LambdaCostTerm;
 class ContainerBase;
 class StagePrivate;
+class StageTelemetry;
 class Stage
 {
 public:
@@ -256,6 +258,21 @@ public:
 	[[noreturn]] void reportPropertyError(const Property::error& e);
 
 	double getTotalComputeTime() const;
+	/// Telemetry recorded since the last reset: compute and wait time histograms, queue depths, and throughput
+	const StageTelemetry& telemetry() const;
+
+	/// Arena providing memory for states and solutions, shared by all stages of a task
+	const ArenaPtr& arena() const;
+	/// allocator drawing memory from the stage's arena
+	template <typename T>
+	ArenaAllocator<T> allocator() const {
+		return ArenaAllocator<T>(arena());
+	}
+	/// create a shared object, e.g. a solution, using memory from the stage's arena
+	template <typename T, typename... Args>
+	std::shared_ptr<T> makeShared(Args&&... args) const {
+		return std::allocate_shared<T>(allocator<T>(), std::forward<Args>(args)...);
+	}
 
 protected:
 	/// Stage can only be instantiated through derived classes
@@ -274,9 +291,38 @@ class ComputeBase : public Stage
 public:
 	PRIVATE_CLASS(ComputeBase)
 
+	void reset() override;
+
+	/** Limit the number of asynchronous requests (see finishAsync()) kept in flight.
+	 *
+	 * 0 (default) requests synchronous computation. Stages supporting asynchronous requests
+	 * keep processing new input states while up to max requests are pending. */
+	void setMaxPendingRequests(std::size_t max);
+	std::size_t maxPendingRequests() const;
+	/// number of asynchronous requests currently in flight
+	std::size_t numPendingRequests() const;
+
+	/** Set storage policy of the interfaces providing input states (default: SORTED)
+	 *
+	 * A BOUNDED interface only keeps the capacity best states, such that a prolific upstream stage
+	 * cannot flood this stage with states it will never get to consume. Not supported by Connecting stages.
+	 */
+	void setInterfaceStorage(Interface::Storage storage, std::size_t capacity = 0);
+	Interface::Storage interfaceStorage() const;
+
 protected:
 	/// ComputeBase can only be instantiated by derived classes in stage.cpp
 	ComputeBase(ComputeBasePrivate* impl);
+
+	/** Complete an asynchronous computation (e.g. a planning request) within a later compute() step.
+	 *
+	 * Once ready() returns true, finish() is called from the task's compute loop,
+	 * where it can safely send, spawn, or connect solutions.
+	 * If the stage has nothing else to do, it calls wait() to block until the request is ready.
+	 * cancel() is called instead, if the request is discarded by reset().
+	 * The stage remains computable as long as requests are pending. */
+	void finishAsync(std::function<bool()> ready, std::function<void()> wait, std::function<void()> finish,
+	                 std::function<void()> cancel = std::function<void()>());
 };
 
 class PropagatingEitherWayPrivate;
@@ -373,6 +419,12 @@ public:
 		spawn(std::move(state), std::move(trajectory));
 	}
 
+	/** Declare a lower bound for the cost of solutions spawned in future (default: 0)
+	 *
+	 * Used by Task::pendingCostLowerBound() while the generator can still compute. */
+	void setCostLowerBound(double bound);
+	double costLowerBound() const;
+
 protected:
 	Generator(GeneratorPrivate* impl);
 };
@@ -412,6 +464,12 @@ public:
 
 	virtual void compute(const InterfaceState& from, const InterfaceState& to) = 0;
 
+	using StatePairs = std::vector<std::pair<const InterfaceState*, const InterfaceState*>>;
+	/// maximum number of pending state pairs processed by a single computeBatch() call
+	virtual std::size_t batchSize() const { return 1; }
+	/// compute several state pairs (sorted by priority), by default calling compute() for each of them
+	virtual void computeBatch(const StatePairs& pairs);
+
 protected:
 	virtual bool compatible(const InterfaceState& from_state, const InterfaceState& to_state) const;
 
@@ -420,7 +478,7 @@ protected:
 
 	/// convienency methods consuming a SubTrajectory
 	void connect(const InterfaceState& from, const InterfaceState& to, SubTrajectory&& trajectory) {
-		connect(from, to, std::make_shared<SubTrajectory>(std::move(trajectory)));
+		connect(from, to, makeShared<SubTrajectory>(std::move(trajectory)));
 	}
 	void connect(const InterfaceState& from, const InterfaceState& to, SubTrajectory&& trajectory, double cost) {
 		trajectory.setCost(cost);
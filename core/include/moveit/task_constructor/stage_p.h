@@ -42,12 +42,18 @@
 #include <moveit/task_constructor/storage.h>
 #include <moveit/task_constructor/cost_terms.h>
 #include <moveit/task_constructor/cost_queue.h>
+#include <moveit/task_constructor/telemetry.h>
 
 #include <rclcpp/rclcpp.hpp>
 #include <fmt/format.h>
 
 #include <ostream>
 #include <chrono>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 // define pimpl() functions accessing correctly casted pimpl_ pointer
 #define PIMPL_FUNCTIONS(Class)                           \
@@ -68,7 +74,52 @@ public:
 	explicit PreemptStageException() {}
 };
 
+/** Record of solution-graph updates issued by a stage that computes concurrently to its siblings.
+ *
+ * While a CommitBuffer is recording on the current thread, StagePrivate::sendForward(), sendBackward(),
+ * spawn(), connect(), and ContainerBasePrivate::liftSolution() don't modify interfaces or solutions,
+ * but defer the operation. Deferred commits are replayed later - sequentially and in a deterministic order -
+ * by the container, which dispatched the concurrent computation.
+ */
+class CommitBuffer
+{
+public:
+	using Commit = std::function<void()>;
+
+	/// buffer recording on the current thread (if any)
+	static CommitBuffer* active() { return active_; }
+
+	/// call compute() with this buffer recording all commits issued from the current thread
+	template <typename F>
+	void record(F&& compute) {
+		struct Scope
+		{
+			CommitBuffer* previous_;
+			Scope(CommitBuffer* buffer) : previous_(active_) { active_ = buffer; }
+			~Scope() { active_ = previous_; }
+		} scope(this);
+		compute();
+	}
+
+	void defer(Commit&& commit) { commits_.push_back(std::move(commit)); }
+
+	/// apply all recorded commits in order
+	void replay() {
+		assert(active_ != this);
+		while (!commits_.empty()) {
+			Commit commit = std::move(commits_.front());
+			commits_.pop_front();
+			commit();
+		}
+	}
+
+private:
+	std::deque<Commit> commits_;
+	static thread_local CommitBuffer* active_;
+};
+
 class ContainerBase;
+class ThreadPool;
 class StagePrivate
 {
 	friend class Stage;
@@ -95,6 +146,21 @@ public:
 	virtual bool canCompute() const = 0;
 	virtual void compute() = 0;
 
+	/// Can compute() run concurrently to siblings, deferring all its commits via CommitBuffer?
+	/// This requires compute() to only modify the stage's own (sub)tree.
+	virtual bool canComputeConcurrently() const { return false; }
+
+	/// priority of the most promising state (pair) pending for computation, used for scheduling
+	virtual InterfaceState::Priority pendingPriority() const;
+	/// lower bound for the cost of solutions computed without a pending state, e.g. by generators
+	virtual double newSolutionCostLowerBound() const { return 0.0; }
+	/// priority reported if no state (pair) is pending, ranking behind all pending ones
+	static InterfaceState::Priority noPendingPriority() {
+		return InterfaceState::Priority(0u, std::numeric_limits<double>::infinity());
+	}
+	/// number of compute() calls since last reset
+	inline std::size_t numComputes() const { return num_computes_; }
+
 	inline const Stage* me() const { return me_; }
 	inline Stage* me() { return me_; }
 	inline const std::string& name() const { return name_; }
@@ -137,6 +203,12 @@ public:
 	/// to setup the connection structure of their children
 	inline void setParentPosition(container_type::iterator it) { it_ = it; }
 	inline void setIntrospection(Introspection* introspection) { introspection_ = introspection; }
+	inline void setThreadPool(ThreadPool* thread_pool) { thread_pool_ = thread_pool; }
+	/// task's thread pool, nullptr if stages should be computed sequentially
+	inline ThreadPool* threadPool() const { return thread_pool_; }
+	/// arena providing memory for states and solutions, states already allocated are kept until reset()
+	void setArena(const ArenaPtr& arena);
+	inline const ArenaPtr& arena() const { return arena_; }
 
 	inline void setPrevEnds(const InterfacePtr& prev_ends) { prev_ends_ = prev_ends; }
 	inline void setNextStarts(const InterfacePtr& next_starts) { next_starts_ = next_starts; }
@@ -153,7 +225,20 @@ public:
 	void connect(const InterfaceState& from, const InterfaceState& to, const SolutionBasePtr& solution);
 
 	bool storeSolution(const SolutionBasePtr& solution, const InterfaceState* from, const InterfaceState* to);
+	/** Discard stored solutions matching the predicate
+	 *
+	 * Discarded solutions are explicitly marked as failures (with the given comment) and thus counted as such.
+	 * They remain linked to their start/end states. Returns the discarded solutions.
+	 */
+	std::vector<SolutionBaseConstPtr> discardSolutions(const std::function<bool(const SolutionBase&)>& predicate,
+	                                                   const std::string& comment);
 	void newSolution(const SolutionBasePtr& solution);
+	/// call f(InterfaceState&) for all states created by this stage
+	template <typename F>
+	void forEachState(F&& f) {
+		for (InterfaceState& state : states_)
+			f(state);
+	}
 	bool storeFailures() const { return introspection_ != nullptr; }
 	void runCompute() {
 		RCLCPP_DEBUG_STREAM(LOGGER, fmt::format("Computing stage '{}'", name()));
@@ -161,6 +246,7 @@ public:
 		if (preempted())
 			throw PreemptStageException();
 
+		const std::size_t queue_depth = queueDepth();
 		auto compute_start_time = std::chrono::steady_clock::now();
 		try {
 			compute();
@@ -169,8 +255,14 @@ public:
 		}
 		auto compute_stop_time = std::chrono::steady_clock::now();
 		total_compute_time_ += compute_stop_time - compute_start_time;
+		++num_computes_;
+		telemetry_.recordCompute(compute_start_time, compute_stop_time, queue_depth);
 	}
 
+	/// number of states (or state pairs) pending for computation, recorded as telemetry before each compute()
+	virtual std::size_t queueDepth() const;
+	StageTelemetry& telemetry() { return telemetry_; }
+
 	/** compute cost for solution through configured CostTerm */
 	void computeCost(const InterfaceState& from, const InterfaceState& to, SolutionBase& solution);
 
@@ -197,11 +289,16 @@ protected:
 
 	// The total compute time
 	std::chrono::duration<double> total_compute_time_;
+	// The number of compute() calls
+	std::size_t num_computes_ = 0;
+	// compute/wait time histograms, queue depths, and throughput
+	StageTelemetry telemetry_;
 
 	// functions called for each new solution
 	std::list<Stage::SolutionCallback> solution_cbs_;
 
-	std::list<InterfaceState> states_;  // storage for created states
+	using StateList = std::list<InterfaceState, ArenaAllocator<InterfaceState>>;
+	StateList states_;  // storage for created states
 	ordered<SolutionBaseConstPtr> solutions_;
 	std::list<SolutionBaseConstPtr> failures_;
 	std::size_t num_failures_ = 0;  // num of failures if not stored
@@ -217,6 +314,8 @@ private:
 	InterfaceWeakPtr next_starts_;  // interface to be used for sendForward()
 
 	Introspection* introspection_;  // task's introspection instance
+	ThreadPool* thread_pool_;  // task's thread pool
+	ArenaPtr arena_;  // task's arena providing memory for states and solutions
 	const std::atomic<bool>* preempt_requested_;
 
 	inline static const rclcpp::Logger LOGGER = rclcpp::get_logger("stage");
@@ -253,7 +352,40 @@ class ComputeBasePrivate : public StagePrivate
 public:
 	ComputeBasePrivate(Stage* me, const std::string& name) : StagePrivate(me, name) {}
 
+	bool canComputeConcurrently() const override { return true; }
+
+	/// asynchronous request, finished within a later compute() step
+	struct AsyncRequest
+	{
+		std::function<bool()> ready;
+		std::function<void()> wait;
+		std::function<void()> finish;
+		std::function<void()> cancel;
+	};
+
+	inline bool hasPendingRequests() const { return !pending_requests_.empty(); }
+	/// can another request be started? (synchronous stages always accept a single one)
+	inline bool acceptsRequests() const {
+		return pending_requests_.empty() || pending_requests_.size() < max_pending_requests_;
+	}
+	/// finish all ready requests, returns their number
+	std::size_t finishReadyRequests();
+	/// block until the oldest request becomes ready and finish it
+	void finishOldestRequest();
+	/// cancel and discard all pending requests
+	void cancelRequests();
+
+protected:
+	/// create a pull interface using the storage policy, states dropped by it are PRUNED via the parent
+	InterfacePtr createPullInterface(Interface::Direction dir);
+
+	// storage policy of pull interfaces
+	Interface::Storage interface_storage_ = Interface::SORTED;
+	std::size_t interface_capacity_ = 0;
+
 private:
+	std::deque<AsyncRequest> pending_requests_;
+	std::size_t max_pending_requests_ = 0;
 };
 PIMPL_FUNCTIONS(ComputeBase)
 
@@ -307,6 +439,9 @@ public:
 	InterfaceFlags requiredInterface() const override;
 	bool canCompute() const override;
 	void compute() override;
+	double newSolutionCostLowerBound() const override { return cost_lower_bound_; }
+
+	double cost_lower_bound_ = 0.0;
 };
 PIMPL_FUNCTIONS(Generator)
 
@@ -362,11 +497,78 @@ public:
 		}
 	};
 
+	/** Pending state pairs, indexed by their start and end states
+	 *
+	 * Pairs are ranked in a lazily-updated priority queue: a queue entry remembers the priorities of both states
+	 * when it was queued. If a state's priority changes, update() re-queues all pairs involving this state,
+	 * outdating their previous entries, which are skipped when reaching the top of the queue.
+	 * Among pairs of equal priority, the earlier queued one comes first.
+	 */
+	class PendingPairs
+	{
+	public:
+		void insert(const StatePair& pair);
+		/// re-rank all pairs involving state after its priority has changed
+		void update(const InterfaceState* state);
+
+		bool empty() const { return size_ == 0; }
+		std::size_t size() const { return size_; }
+		void clear();
+
+		/// best pending pair (requires !empty())
+		const StatePair& top() const;
+		StatePair pop();
+
+		/// pairs involving state, in insertion order
+		std::vector<StatePair> pairsOf(const InterfaceState* state) const;
+		/// all pairs sorted by priority
+		std::vector<StatePair> sorted() const;
+
+	private:
+		struct Node
+		{
+			StatePair pair;
+			std::size_t version;  // version of the node's valid queue entry
+			std::size_t seq;  // queueing order of the valid entry
+			bool alive;
+		};
+		struct Entry
+		{
+			InterfaceState::Priority first, second;  // priorities at queueing time
+			std::size_t seq;
+			std::size_t node;
+			std::size_t version;
+		};
+		struct Later
+		{
+			bool operator()(const Entry& a, const Entry& b) const;
+		};
+
+		void enqueue(std::size_t node);
+		// discard outdated entries and re-queue entries whose states changed priority unnoticed
+		void cleanup() const;
+		// drop all outdated entries once they outnumber the valid ones
+		void compact();
+		void unlink(std::size_t node, const InterfaceState* state);
+
+		std::vector<Node> nodes_;  // pending pairs and popped ones, whose nodes are reused
+		std::vector<std::size_t> free_;  // nodes of popped pairs
+		std::unordered_map<const InterfaceState*, std::vector<std::size_t>> adjacency_;
+		mutable std::vector<Entry> queue_;  // heap ordered by Later
+		std::size_t size_ = 0;
+		std::size_t seq_ = 0;
+	};
+
 	inline ConnectingPrivate(Connecting* me, const std::string& name);
 
 	InterfaceFlags requiredInterface() const override;
 	bool canCompute() const override;
 	void compute() override;
+	InterfaceState::Priority pendingPriority() const override;
+	std::size_t queueDepth() const override { return pending.size(); }
+
+	// Do we still have feasible pending state pairs?
+	bool hasPendingPairs() const;
 
 	// Check whether there are pending feasible states that could connect to source
 	template <Interface::Direction dir>
@@ -382,9 +584,16 @@ private:
 	// notify callback to get informed about newly inserted (or updated) start or end states
 	template <Interface::Direction other>
 	void newState(Interface::iterator it, Interface::UpdateFlags updated);
-
-	// ordered list of pending state pairs
-	ordered<StatePair> pending;
+	// re-rank pending pairs involving state, also in the pending lists sharing our interface states
+	void updatePending(const InterfaceState* state);
+
+	// pending state pairs, ranked by priority
+	PendingPairs pending;
+	// pending lists of other stages holding pairs of our interface states (subsequent Fallbacks children),
+	// which are not notified about priority updates themselves
+	std::vector<PendingPairs*> shared_pending_;
+	// guards to not propagate state updates back and forth between both interfaces
+	bool propagating_[2] = { false, false };
 };
 PIMPL_FUNCTIONS(Connecting)
 
@@ -107,11 +107,25 @@ public:
 	}
 
 	void setMaxIKSolutions(uint32_t n) { setProperty("max_ik_solutions", n); }
+	/** Search for IK solutions from multiple random seeds concurrently
+	 *
+	 * Searches run on the task's thread pool (see Task::setNumThreads()) and operate on their own copy of the
+	 * robot state. Requires a thread-safe kinematics solver. Without a thread pool, a single search is run.
+	 * Only effective if max_ik_solutions > 1. Solutions are reported in the order they were found.
+	 */
+	void setNumIKThreads(uint32_t n) { setProperty("num_ik_threads", n); }
 	void setIgnoreCollisions(bool flag) { setProperty("ignore_collisions", flag); }
 	void setMinSolutionDistance(double distance) { setProperty("min_solution_distance", distance); }
 
 protected:
 	ordered<const SolutionBase*> upstream_solutions_;
+
+	// handles to frequently accessed properties, resolved in init()
+	PropertyHandle<double> timeout_;
+	PropertyHandle<bool> ignore_collisions_;
+	PropertyHandle<double> min_solution_distance_;
+	PropertyHandle<uint32_t> max_ik_solutions_;
+	PropertyHandle<uint32_t> num_ik_threads_;
 };
 }  // namespace stages
 }  // namespace task_constructor
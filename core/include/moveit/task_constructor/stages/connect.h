@@ -86,12 +86,31 @@ public:
 	void setPathConstraints(moveit_msgs::msg::Constraints path_constraints) {
 		setProperty("path_constraints", std::move(path_constraints));
 	}
+	/** Plan up to max pending state pairs concurrently.
+	 *
+	 * Each concurrently planned pair uses its own clone of the planners (see PlannerInterface::clone()).
+	 * Planning runs on the task's thread pool (see Task::setNumThreads()).
+	 * Results are reported in priority order of the pairs. */
+	void setMaxConcurrentPairs(uint32_t max) { setProperty("max_concurrent_pairs", max); }
 
 	void reset() override;
 	void init(const moveit::core::RobotModelConstPtr& robot_model) override;
 	void compute(const InterfaceState& from, const InterfaceState& to) override;
+	std::size_t batchSize() const override;
+	void computeBatch(const StatePairs& pairs) override;
 
 protected:
+	struct Attempt;
+	using AttemptPtr = std::shared_ptr<Attempt>;
+	AttemptPtr makeAttempt(const InterfaceState& from, const InterfaceState& to,
+	                       const GroupPlannerVector& planners) const;
+	// plan remaining sub trajectories of attempt
+	void plan(const AttemptPtr& attempt);
+	// create and connect solution from (failed or successful) attempt
+	void finish(const Attempt& attempt);
+	// clone planners as required by max_concurrent_pairs
+	void initPlannerClones(const moveit::core::RobotModelConstPtr& robot_model);
+
 	SolutionSequencePtr makeSequential(const std::vector<PlannerIdTrajectoryPair>& sub_trajectories,
 	                                   const std::vector<planning_scene::PlanningSceneConstPtr>& intermediate_scenes,
 	                                   const InterfaceState& from, const InterfaceState& to);
@@ -101,9 +120,11 @@ protected:
 
 protected:
 	GroupPlannerVector planner_;
+	// planners used to plan additional pairs concurrently
+	std::vector<GroupPlannerVector> planner_clones_;
 	moveit::core::JointModelGroupPtr merged_jmg_;
-	std::list<SubTrajectory> subsolutions_;
-	std::list<InterfaceState> states_;
+	std::list<SubTrajectory, ArenaAllocator<SubTrajectory>> subsolutions_;
+	std::list<InterfaceState, ArenaAllocator<InterfaceState>> states_;
 };
 }  // namespace stages
 }  // namespace task_constructor
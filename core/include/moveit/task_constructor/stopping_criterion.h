@@ -0,0 +1,140 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:    Criteria to stop planning early, e.g. once the best solution converged
+*/
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+
+#include <cstddef>
+#include <limits>
+
+namespace moveit {
+namespace task_constructor {
+
+class Task;
+MOVEIT_CLASS_FORWARD(StoppingCriterion);
+
+/// Snapshot of the planning progress, evaluated by StoppingCriteria after each iteration of Task::plan()
+struct PlanningProgress
+{
+	const Task& task;
+	/// number of finished iterations, i.e. compute() calls of the task
+	std::size_t iteration;
+	/// time elapsed since start of planning (s)
+	double elapsed_time;
+	/// number of solutions found so far
+	std::size_t num_solutions;
+	/// cost of the best solution, infinity if there is none yet
+	double best_cost;
+};
+
+/** A StoppingCriterion decides whether Task::plan() should stop early (anytime planning).
+ *
+ * Criteria are added via Task::addStoppingCriterion(). Planning stops as soon as any of them is met.
+ * Criteria might track the progress over several iterations. reset() is called when planning starts.
+ */
+class StoppingCriterion
+{
+public:
+	virtual ~StoppingCriterion() = default;
+
+	virtual void reset() {}
+	/// should planning stop?
+	virtual bool stop(const PlanningProgress& progress) = 0;
+};
+
+/// Stop as soon as a solution with a cost of at most the given threshold was found
+class CostThresholdCriterion : public StoppingCriterion
+{
+public:
+	explicit CostThresholdCriterion(double threshold) : threshold_(threshold) {}
+
+	bool stop(const PlanningProgress& progress) override;
+
+private:
+	double threshold_;
+};
+
+/** Stop when the best solution cost has converged
+ *
+ * Stop if the best cost was not improved by more than the given fraction (relative improvement)
+ * for the given duration (s) or number of iterations, whatever comes first.
+ * Improvements up to min_absolute_improvement are never significant, which matters for costs close to zero.
+ */
+class ConvergenceCriterion : public StoppingCriterion
+{
+public:
+	explicit ConvergenceCriterion(double min_improvement, double duration = std::numeric_limits<double>::infinity(),
+	                              std::size_t iterations = std::numeric_limits<std::size_t>::max(),
+	                              double min_absolute_improvement = 1e-6);
+
+	void reset() override;
+	bool stop(const PlanningProgress& progress) override;
+
+private:
+	double min_improvement_;
+	double min_absolute_improvement_;
+	double duration_;
+	std::size_t iterations_;
+
+	// best cost at last significant improvement, and time / iteration it occurred
+	double reference_cost_;
+	double reference_time_;
+	std::size_t reference_iteration_;
+};
+
+/** Stop when the pending work cannot yield a better solution
+ *
+ * Uses Task::pendingCostLowerBound() to estimate the best cost achievable by all pending partial solutions.
+ * This assumes non-negative and additive costs.
+ * Note that active generators bound the cost to zero, unless they declare a lower bound for their future
+ * solutions via Generator::setCostLowerBound(). Hence, this criterion only fires once all generators are
+ * exhausted or their declared bound is reached.
+ */
+class LowerBoundCriterion : public StoppingCriterion
+{
+public:
+	/// stop if the lower bound does not undercut the incumbent by more than the given tolerance
+	explicit LowerBoundCriterion(double tolerance = 0.0) : tolerance_(tolerance) {}
+
+	bool stop(const PlanningProgress& progress) override;
+
+private:
+	double tolerance_;
+};
+}  // namespace task_constructor
+}  // namespace moveit
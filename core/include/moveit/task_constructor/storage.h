@@ -48,10 +48,14 @@
 
 #include <list>
 #include <vector>
+#include <iterator>
+#include <memory>
+#include <chrono>
 #include <deque>
 #include <cassert>
 #include <functional>
 #include <cmath>
+#include <optional>
 
 namespace planning_scene {
 MOVEIT_CLASS_FORWARD(PlanningScene);
@@ -78,7 +82,7 @@ class InterfaceState
 {
 	friend class SolutionBase;  // addIncoming() / addOutgoing() should be called only by SolutionBase
 	friend class Interface;  // allow Interface to set owner_ and priority_
-	friend class ContainerBasePrivate;  // allow setting priority_ for pruning
+	friend class ContainerBasePrivate;  // allow setting priority_ for pruning, and linking internal/external states
 
 public:
 	enum Status : uint8_t
@@ -148,6 +152,8 @@ public:
 	void updateStatus(Status status);
 
 	Interface* owner() const { return owner_; }
+	/// time at which the state was added to its current (or last) interface
+	std::chrono::steady_clock::time_point enqueueTime() const { return enqueue_time_; }
 
 private:
 	// these methods should be only called by SolutionBase::set[Start|End]State()
@@ -168,12 +174,33 @@ private:
 	// members needed for priority scheduling in Interface list
 	Priority priority_;
 	Interface* owner_ = nullptr;  // allow update of priority
+	std::list<InterfaceState*>::iterator owner_it_;  // position within owner_ (valid if owner_ != nullptr)
+	std::chrono::steady_clock::time_point enqueue_time_;  // time of Interface::add(), used for telemetry
+
+	// links between states of a container's children (internal) and the container's (external) states
+	InterfaceState* external_ = nullptr;  // corresponding state at the parent container's level
+	InterfaceState* first_internal_ = nullptr;  // head of internal states linked to this (external) one
+	InterfaceState* next_internal_ = nullptr;  // next internal state linked to the same external one
 };
 
-/** Interface provides a cost-sorted list of InterfaceStates available as input for a stage. */
-class Interface : public ordered<InterfaceState*>
+/// Order of InterfaceStates within an Interface: by priority or, if by_status_only, only by status
+struct InterfaceStateLess
 {
-	using base_type = ordered<InterfaceState*>;
+	bool by_status_only = false;
+
+	bool operator()(const InterfaceState* lhs, const InterfaceState* rhs) const {
+		return by_status_only ? lhs->priority().status() < rhs->priority().status() : *lhs < *rhs;
+	}
+};
+
+/** Interface provides a cost-sorted list of InterfaceStates available as input for a stage.
+ *
+ * Depending on its storage policy, the list might be kept in order of arrival instead,
+ * or be bounded in size, dropping the lowest-priority states.
+ */
+class Interface : public ordered<InterfaceState*, InterfaceStateLess>
+{
+	using base_type = ordered<InterfaceState*, InterfaceStateLess>;
 
 public:
 	// iterators providing convinient access to stored InterfaceState
@@ -212,6 +239,14 @@ public:
 	using UpdateFlags = utils::Flags<Update>;
 	using NotifyFunction = std::function<void(iterator, UpdateFlags)>;
 
+	/// storage policy, determining the order of states and how many of them are kept
+	enum Storage : uint8_t
+	{
+		SORTED,  // states are sorted by priority (default)
+		FIFO,  // enabled states first, otherwise in order of arrival
+		BOUNDED,  // sorted by priority, keeping at most capacity() states
+	};
+
 	class DisableNotify
 	{
 		Interface& if_;
@@ -223,9 +258,31 @@ public:
 	};
 	friend class DisableNotify;
 
-	Interface(const NotifyFunction& notify = NotifyFunction());
+	Interface(const NotifyFunction& notify = NotifyFunction(), Storage storage = SORTED, std::size_t capacity = 0);
 
-	/// add a new InterfaceState
+	/** Change the storage policy, resorting existing states
+	 *
+	 * A BOUNDED interface keeps the capacity best states, dropping lowest-priority states beyond.
+	 * This is not supported for interfaces notifying their stage about updates (e.g. of Connecting stages),
+	 * as these stages keep track of the interface's states themselves.
+	 */
+	void setStorage(Storage storage, std::size_t capacity = 0);
+	Storage storage() const { return storage_; }
+	std::size_t capacity() const { return capacity_; }
+	/// number of states dropped due to exceeded capacity
+	std::size_t numDropped() const { return num_dropped_; }
+	/// function called for each state dropped due to exceeded capacity (after its removal)
+	using DropFunction = std::function<void(InterfaceState*)>;
+	void setDropFunction(const DropFunction& dropped) { dropped_ = dropped; }
+
+	/// remove all states
+	void clear() {
+		base_type::clear();
+		num_dropped_ = 0;
+		lowest_enabled_cost_.reset();
+	}
+
+	/// add a new InterfaceState (which might be dropped immediately if it exceeds the capacity)
 	void add(InterfaceState& state);
 
 	/// remove a state from the interface and return it as a one-element list
@@ -233,13 +290,32 @@ public:
 
 	/// update state's priority (and call notify_ if it really has changed)
 	void updatePriority(InterfaceState* state, const InterfaceState::Priority& priority);
+
+	/// iterator referring to a state owned by this interface (constant time)
+	iterator find(InterfaceState* state) {
+		assert(state->owner_ == this);
+		return state->owner_it_;
+	}
+	const_iterator find(const InterfaceState* state) const {
+		assert(state->owner_ == this);
+		return base_type::const_iterator(state->owner_it_);
+	}
 	inline bool notifyEnabled() const { return static_cast<bool>(notify_); }
 
+	/// lowest cost of all enabled states (infinity if there is none), cached until the states change
+	double lowestEnabledCost() const;
+
 private:
 	NotifyFunction notify_;
+	DropFunction dropped_;
+	Storage storage_ = SORTED;
+	std::size_t capacity_ = 0;
+	std::size_t num_dropped_ = 0;
+	// cache of lowestEnabledCost(), updated incrementally if possible and reset otherwise
+	mutable std::optional<double> lowest_enabled_cost_;
 
 	// restrict access to some functions to ensure consistency
-	// (we need to set/unset InterfaceState::owner_)
+	// (we need to set/unset InterfaceState::owner_ and owner_it_)
 	using base_type::erase;
 	using base_type::insert;
 	using base_type::moveFrom;
@@ -382,16 +458,82 @@ MOVEIT_CLASS_FORWARD(SubTrajectory);
  *
  * A solution sequence describes a solution that is composed from several individual
  * sub solutions that need to be chained together to yield the overall solutions.
+ *
+ * The sub solutions are stored in segments, which can be shared between several sequences,
+ * e.g. the common prefix or suffix of all solutions of a SerialContainer passing through a child solution.
  */
 class SolutionSequence : public SolutionBase
 {
 public:
 	using container_type = std::vector<const SolutionBase*>;
+	/// immutable, shareable part of a sequence
+	using Segment = std::shared_ptr<const container_type>;
+	using Segments = std::vector<Segment>;
 
-	explicit SolutionSequence() : SolutionBase() {}
-	SolutionSequence(container_type&& subsolutions, double cost = 0.0, Stage* creator = nullptr)
-	  : SolutionBase(creator, cost), subsolutions_(std::move(subsolutions)) {}
+	/// read-only range of all sub solutions, iterating over all segments
+	class Solutions
+	{
+	public:
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = const SolutionBase*;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+
+			explicit const_iterator(Segments::const_iterator segment) : segment_(segment) {}
+
+			reference operator*() const { return (**segment_)[index_]; }
+			pointer operator->() const { return &(**segment_)[index_]; }
+			const_iterator& operator++() {
+				if (++index_ == (*segment_)->size()) {  // advance to next segment (segments are never empty)
+					++segment_;
+					index_ = 0;
+				}
+				return *this;
+			}
+			const_iterator operator++(int) {
+				const_iterator result = *this;
+				++*this;
+				return result;
+			}
+			bool operator==(const const_iterator& other) const {
+				return segment_ == other.segment_ && index_ == other.index_;
+			}
+			bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+		private:
+			Segments::const_iterator segment_;
+			std::size_t index_ = 0;
+		};
+		using iterator = const_iterator;
+
+		Solutions(const Segments& segments, std::size_t size) : segments_(segments), size_(size) {}
+
+		const_iterator begin() const { return const_iterator(segments_.begin()); }
+		const_iterator end() const { return const_iterator(segments_.end()); }
+		std::size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		const SolutionBase* front() const { return segments_.front()->front(); }
+		const SolutionBase* back() const { return segments_.back()->back(); }
+		const SolutionBase* operator[](std::size_t index) const;
+
+	private:
+		const Segments& segments_;
+		std::size_t size_;
+	};
 
+	explicit SolutionSequence() : SolutionBase() {}
+	SolutionSequence(container_type&& subsolutions, double cost = 0.0, Stage* creator = nullptr);
+	/// create a sequence from the concatenation of (shared) segments
+	SolutionSequence(Segments&& segments, double cost = 0.0, Stage* creator = nullptr);
+	SolutionSequence(const SolutionSequence& other);
+	SolutionSequence(SolutionSequence&& other) = default;
+	SolutionSequence& operator=(SolutionSequence other);
+
+	/// append solution, never modifying segments shared with other sequences
 	void push_back(const SolutionBase& solution);
 
 	/// append all subsolutions to solution
@@ -399,14 +541,17 @@ public:
 
 	double computeCost(const CostTerm& cost, std::string& comment) const override;
 
-	const container_type& solutions() const { return subsolutions_; }
+	Solutions solutions() const { return Solutions(segments_, size_); }
 
-	inline const InterfaceState* internalStart() const { return subsolutions_.front()->start(); }
-	inline const InterfaceState* internalEnd() const { return subsolutions_.back()->end(); }
+	inline const InterfaceState* internalStart() const { return segments_.front()->front()->start(); }
+	inline const InterfaceState* internalEnd() const { return segments_.back()->back()->end(); }
 
 private:
-	/// series of sub solutions
-	container_type subsolutions_;
+	/// series of sub solutions, split into non-empty segments
+	Segments segments_;
+	/// last segment, if owned exclusively by this sequence and thus extendable
+	std::shared_ptr<container_type> tail_;
+	std::size_t size_ = 0;
 };
 MOVEIT_CLASS_FORWARD(SolutionSequence);
 
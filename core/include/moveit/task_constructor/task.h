@@ -42,12 +42,14 @@
 #include "container.h"
 
 #include <moveit/task_constructor/introspection.h>
+#include <moveit/task_constructor/stopping_criterion.h>
 #include <moveit_task_constructor_msgs/msg/solution.hpp>
 #include <moveit_task_constructor_msgs/action/execute_task_solution.hpp>
 
 #include <moveit/macros/class_forward.hpp>
 
 #include <moveit_msgs/msg/move_it_error_codes.hpp>
+#include <moveit_msgs/msg/planning_scene.hpp>
 #include <moveit/utils/moveit_error_code.hpp>
 
 #include <rclcpp/node.hpp>
@@ -113,6 +115,24 @@ public:
 	/// remove function callback
 	void eraseTaskCallback(TaskCallbackList::const_iterator which);
 
+	/** Add a criterion to stop planning early (anytime planning)
+	 *
+	 * Criteria are evaluated after each iteration of plan(), which stops as soon as any of them is met.
+	 */
+	void addStoppingCriterion(const StoppingCriterionPtr& criterion);
+	/// remove all stopping criteria
+	void clearStoppingCriteria();
+
+	/** Lower bound of the cost of any solution resulting from pending (partial) solutions
+	 *
+	 * Assuming non-negative, additive costs, the cost of any partial solution bounds the final cost.
+	 * Stages that could compute without a pending state (e.g. generators) yield a bound of zero, unless a generator
+	 * declares a higher bound via Generator::setCostLowerBound(). Hence, the bound remains zero while such a stage
+	 * is active.
+	 * Returns infinity if there is no pending work at all.
+	 */
+	double pendingCostLowerBound() const;
+
 	/// expose SolutionCallback API
 	using WrapperBase::addSolutionCallback;
 	using WrapperBase::removeSolutionCallback;
@@ -121,7 +141,22 @@ public:
 	using WrapperBase::setTimeout;
 	using WrapperBase::timeout;
 
+	/// arena providing memory for the states and solutions of the current planning run
+	using WrapperBase::arena;
+
+	/** Set number of threads used to compute independent stages concurrently (default: 1)
+	 *
+	 * By default, all stages are computed sequentially in the planning thread.
+	 * With more than one thread, stages of a SerialContainer that are ready to compute are dispatched
+	 * to a thread pool. Their results are merged into the solution graph sequentially afterwards.
+	 * Note, that solvers shared between several stages need to be thread-safe then.
+	 */
+	void setNumThreads(size_t num_threads);
+	size_t numThreads() const;
+
 	using WrapperBase::pruning;
+	using WrapperBase::setSchedulerPolicy;
+	using WrapperBase::schedulerPolicy;
 	using WrapperBase::setPruning;
 
 	/// reset all stages
@@ -131,6 +166,34 @@ public:
 
 	/// reset, init scene (if not yet done), and init all stages, then start planning
 	moveit::core::MoveItErrorCode plan(size_t max_solutions = 0);
+	/** Re-validate existing solutions w.r.t. an updated planning scene
+	 *
+	 * The solutions of all stages are checked in their original scenes updated by the given diff.
+	 * Invalid solutions are marked as failures and their states are pruned, like for any other failure.
+	 * The diff is applied to the scenes of all states, such that planning can continue from them.
+	 * Only the world, the allowed collision matrix, and object colors are considered: the states keep their own
+	 * robot state, including attached objects. Thus a diff of a monitored scene can be passed as is.
+	 * Returns the number of remaining solutions of the task.
+	 */
+	size_t revalidate(const moveit_msgs::msg::PlanningScene& scene_diff);
+	/** Plan again after the planning scene was changed by the given diff
+	 *
+	 * Solutions still valid in the updated scene are kept (see revalidate()) and planning resumes from them
+	 * until max_solutions (0: all) are found, without recomputing any surviving solution.
+	 * Generators spawning new states need to provide the updated scene themselves (e.g. CurrentState).
+	 */
+	moveit::core::MoveItErrorCode replan(const moveit_msgs::msg::PlanningScene& scene_diff, size_t max_solutions = 0);
+	/** Release planning scenes and trajectories of pruned solution branches
+	 *
+	 * Branches, whose states are all PRUNED, cannot become enabled anymore.
+	 * Their states and solutions are kept (and thus their introspection IDs), but their scenes and trajectories
+	 * are released to bound memory of long-running tasks. Only states pruned while collection was enabled
+	 * are considered. Returns the number of released states.
+	 */
+	size_t collectPrunedBranches();
+	/// record pruned states and collect their branches after each planning iteration (default: false)
+	void setCollectPrunedBranches(bool enable);
+
 	/// interrupt current planning
 	void preempt();
 	void resetPreemptRequest();
@@ -169,6 +232,8 @@ protected:
 
 private:
 	using WrapperBase::init;
+	/// plan from the current state of the initialized stage graph, i.e. without calling init()
+	moveit::core::MoveItErrorCode resumePlanning(size_t max_solutions);
 	// persistent node and client to call the ExecuteTaskSolution action and is only created if execute() is called
 	rclcpp::Node::SharedPtr execute_solution_node_;
 	std::shared_ptr<rclcpp_action::Client<moveit_task_constructor_msgs::action::ExecuteTaskSolution>> execute_ac_;
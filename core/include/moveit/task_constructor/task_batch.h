@@ -0,0 +1,129 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:    Plan many structurally identical tasks concurrently
+*/
+
+#pragma once
+
+#include <moveit/task_constructor/task.h>
+#include <moveit_task_constructor_msgs/msg/solution.hpp>
+
+#include <moveit/macros/class_forward.hpp>
+#include <moveit/utils/moveit_error_code.hpp>
+
+#include <boost/any.hpp>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace planning_scene {
+MOVEIT_CLASS_FORWARD(PlanningScene);
+}
+
+namespace moveit {
+namespace task_constructor {
+
+MOVEIT_CLASS_FORWARD(ThreadPool);
+MOVEIT_CLASS_FORWARD(TaskBatch);
+
+/** Plan a batch of structurally identical tasks, differing only in their start scene and properties.
+ *
+ * The stage tree is built once per worker thread by a user-provided factory and reused for all requests
+ * processed by this worker. All tasks share the same robot model and have introspection disabled.
+ * Solvers captured from outside of the factory are shared by all workers and thus need to be thread-safe.
+ * To share expensive resources while keeping per-worker state, capture a prototype solver and pass its
+ * clone() to the worker's stages: e.g. clones of a PipelinePlanner share the prototype's planning pipelines,
+ * which are created only once, but have their own properties.
+ *
+ * The factory should add all stages following the start state: each task starts from the scene of its request.
+ */
+class TaskBatch
+{
+public:
+	/// populate the given (empty) task with stages
+	using TaskFactory = std::function<void(Task& task)>;
+
+	struct Request
+	{
+		/// start scene of the task
+		planning_scene::PlanningSceneConstPtr scene;
+		/// task-level properties to set for this request only
+		std::map<std::string, boost::any> properties;
+	};
+
+	struct Result
+	{
+		moveit::core::MoveItErrorCode error_code;
+		/// found solutions, sorted by cost
+		std::vector<moveit_task_constructor_msgs::msg::Solution> solutions;
+	};
+
+	/** Create worker tasks using the given factory
+	 *
+	 * \param [in] robot_model robot model shared by all tasks
+	 * \param [in] factory function populating each worker's task with stages
+	 * \param [in] num_workers number of tasks planned concurrently, 0 uses the number of hardware threads
+	 */
+	TaskBatch(const moveit::core::RobotModelConstPtr& robot_model, const TaskFactory& factory,
+	          std::size_t num_workers = 0);
+	~TaskBatch();
+
+	TaskBatch(const TaskBatch&) = delete;
+	TaskBatch& operator=(const TaskBatch&) = delete;
+
+	std::size_t numWorkers() const { return workers_.size(); }
+	/// access a worker's task, e.g. to configure it
+	Task& task(std::size_t worker);
+
+	/// plan all requests, returning results in the order of requests
+	std::vector<Result> plan(const std::vector<Request>& requests, std::size_t max_solutions = 1);
+
+	/// interrupt planning: stop all workers and skip remaining requests
+	void preempt();
+
+private:
+	struct Worker;
+	Result plan(Worker& worker, const Request& request, std::size_t max_solutions);
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	ThreadPoolPtr thread_pool_;
+	std::atomic<bool> preempt_requested_{ false };
+};
+}  // namespace task_constructor
+}  // namespace moveit
@@ -40,6 +40,7 @@
 
 #include <moveit/task_constructor/container_p.h>
 #include <moveit/task_constructor/task.h>
+#include <moveit/task_constructor/thread_pool.h>
 
 namespace robot_model_loader {
 MOVEIT_CLASS_FORWARD(RobotModelLoader);
@@ -59,15 +60,28 @@ public:
 	const std::string& ns() const { return ns_; }
 	const ContainerBase* stages() const;
 
+	/// use given arena for the task and all its stages
+	void provideArena(const ArenaPtr& arena);
+
 private:
 	std::string ns_;
 	robot_model_loader::RobotModelLoaderPtr robot_model_loader_;
 	moveit::core::RobotModelConstPtr robot_model_;
 	std::atomic<bool> preempt_requested_;
+	// stage graph was initialized by init() and wasn't reset or extended since
+	bool initialized_ = false;
+
+	// concurrent computation of stages
+	size_t num_threads_;
+	ThreadPoolPtr thread_pool_;
+
+	// release scenes and trajectories of pruned branches after each planning iteration
+	bool collect_pruned_branches_ = false;
 
 	// introspection and monitoring
 	std::unique_ptr<Introspection> introspection_;
 	std::list<Task::TaskCallback> task_cbs_;  // functions to monitor task's planning progress
+	std::vector<StoppingCriterionPtr> stopping_criteria_;  // criteria to stop planning early
 };
 PIMPL_FUNCTIONS(Task)
 }  // namespace task_constructor
@@ -0,0 +1,140 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/* Desc:    Per-stage telemetry: compute and wait time histograms, queue depths, and throughput
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <limits>
+
+namespace moveit {
+namespace task_constructor {
+
+/** Histogram of durations (in seconds) using logarithmically spaced buckets.
+ *
+ * Bucket 0 counts durations below MIN_DURATION, bucket i counts durations in [MIN_DURATION * 2^(i-1), upperBound(i)).
+ * The last bucket is unbounded.
+ */
+class DurationHistogram
+{
+public:
+	static constexpr std::size_t NUM_BUCKETS = 32;
+	static constexpr double MIN_DURATION = 1e-6;
+	using Buckets = std::array<std::size_t, NUM_BUCKETS>;
+
+	void add(double duration);
+	void clear();
+
+	const Buckets& buckets() const { return buckets_; }
+	/// upper (exclusive) bound of bucket i, infinity for the last bucket
+	static double upperBound(std::size_t i);
+
+	std::size_t count() const { return count_; }
+	double sum() const { return sum_; }
+	double mean() const { return count_ ? sum_ / count_ : 0.0; }
+	double min() const { return count_ ? min_ : 0.0; }
+	double max() const { return max_; }
+	/// estimate the q-quantile (0 <= q <= 1), interpolating linearly within a bucket
+	double quantile(double q) const;
+
+private:
+	Buckets buckets_{};
+	std::size_t count_ = 0;
+	double sum_ = 0.0;
+	double min_ = std::numeric_limits<double>::infinity();
+	double max_ = 0.0;
+};
+
+/** Telemetry recorded by a stage during planning
+ *
+ * Each stage records the durations of its compute() calls, the time its inputs (states or state pairs)
+ * waited in its queue before being processed, the queue depth before each compute() call, and the number
+ * of solutions found. All values are cleared on Stage::reset().
+ */
+class StageTelemetry
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct QueueDepthSample
+	{
+		/// time since the stage was reset (s)
+		double time;
+		/// number of pending states or state pairs
+		std::size_t depth;
+	};
+
+	/// Only the most recent max_samples queue depth samples are kept
+	explicit StageTelemetry(std::size_t max_samples = 1000);
+
+	void reset();
+
+	void recordCompute(clock::time_point start, clock::time_point stop, std::size_t queue_depth);
+	void recordWait(clock::time_point enqueued, clock::time_point dequeued);
+	void recordSolution() { ++num_solutions_; }
+
+	const DurationHistogram& computeTimes() const { return compute_times_; }
+	const DurationHistogram& waitTimes() const { return wait_times_; }
+	const std::deque<QueueDepthSample>& queueDepths() const { return queue_depths_; }
+	std::size_t maxQueueDepth() const { return max_queue_depth_; }
+	std::size_t numSolutions() const { return num_solutions_; }
+
+	void setMaxSamples(std::size_t max_samples);
+	std::size_t maxSamples() const { return max_samples_; }
+
+	/// solutions per second of compute time
+	double computeThroughput() const;
+	/// solutions per second of wall time, measured from the first compute() call to the end of the last one
+	double throughput() const;
+
+private:
+	DurationHistogram compute_times_;
+	DurationHistogram wait_times_;
+	std::deque<QueueDepthSample> queue_depths_;
+	std::size_t max_samples_;
+	std::size_t max_queue_depth_ = 0;
+	std::size_t num_solutions_ = 0;
+
+	clock::time_point epoch_;  // time of last reset()
+	clock::time_point first_start_;  // start of first compute() call
+	clock::time_point last_stop_;  // end of last compute() call
+};
+}  // namespace task_constructor
+}  // namespace moveit
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:    Simple thread pool used to compute independent stages concurrently
+*/
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace moveit {
+namespace task_constructor {
+
+MOVEIT_CLASS_FORWARD(ThreadPool);
+
+/** Fixed-size pool of worker threads processing a FIFO queue of jobs.
+ *
+ * A Task owns a pool shared by all its stages, which is also used for asynchronous planning requests.
+ * Jobs are submitted as arbitrary callables and their result is returned via a std::future.
+ * Exceptions thrown by a job are propagated to the caller of std::future::get().
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(std::size_t num_threads);
+	/// finishes all pending jobs and joins the worker threads
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// number of worker threads
+	std::size_t size() const { return workers_.size(); }
+
+	/// enqueue a job for asynchronous execution
+	template <typename F>
+	std::future<std::invoke_result_t<F>> submit(F&& f) {
+		using R = std::invoke_result_t<F>;
+		// std::function requires a copyable callable, but std::packaged_task is move-only
+		auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+		std::future<R> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			jobs_.emplace_back([task]() { (*task)(); });
+		}
+		cv_.notify_one();
+		return result;
+	}
+
+	/** Call f(i) for all i in [0, n), distributing the calls over the calling thread and the pool's workers.
+	 *
+	 * The calling thread processes items itself until none are left and only waits for items already started
+	 * by workers. Hence, this can be safely called from within a job, even if all workers are busy.
+	 * The first exception thrown by f is rethrown after all started items finished.
+	 */
+	void parallelFor(std::size_t n, const std::function<void(std::size_t)>& f);
+
+private:
+	void run();
+
+	std::vector<std::thread> workers_;
+	std::deque<std::function<void()>> jobs_;
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool stop_ = false;
+};
+}  // namespace task_constructor
+}  // namespace moveit
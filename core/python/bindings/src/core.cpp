@@ -365,7 +365,11 @@ void export_core(pybind11::module& m) {
 	        py::keep_alive<0, 1>())  // keep container alive as long as iterator lives
 	    ;
 
-	py::classh<SerialContainer, ContainerBase>(m, "SerialContainer", "Container implementing a linear planning sequence")
+	properties::class_<SerialContainer, ContainerBase>(m, "SerialContainer",
+	                                                   "Container implementing a linear planning sequence")
+	    .property<bool>("incremental_assembly",
+	                    "bool: assemble full solutions from incrementally updated path priorities")
+	    .property<bool>("lazy_enumeration", "bool: lazily lift full solutions in increasing cost order")
 	    .def(py::init<const std::string&>(), "name"_a = std::string("SerialContainer"));
 
 	py::classh<ParallelContainerBase, ContainerBase>(m, "ParallelContainerBase",
@@ -378,7 +382,7 @@ void export_core(pybind11::module& m) {
 			)")
 	    .def(py::init<const std::string&>(), "name"_a = std::string("Alternatives"));
 
-	py::classh<Fallbacks, ParallelContainerBase>(m, "Fallbacks", R"(
+	properties::class_<Fallbacks, ParallelContainerBase>(m, "Fallbacks", R"(
 			Plan for different alternatives in sequence
 			Try to find feasible solutions using the children in sequence. The behaviour slightly differs for the indivual stage types:
 
@@ -388,6 +392,8 @@ void export_core(pybind11::module& m) {
 
 			See :ref:`How-To-Guides <subsubsec-howto-fallbacks>` for an example.
 			)")
+	    .property<uint32_t>("speculative_children",
+	                        "uint: number of subsequent children to compute speculatively in parallel")
 	    .def(py::init<const std::string&>(), "name"_a = std::string("Fallbacks"));
 
 	py::classh<Merger, ParallelContainerBase>(m, "Merger", R"(
@@ -417,6 +423,8 @@ void export_core(pybind11::module& m) {
 	    .def_property_readonly("solutions", &Task::solutions, "Successful Solutions of the stage (read-only)")
 	    .def_property_readonly("failures", &Task::failures, "Solutions: Failed Solutions of the stage (read-only)")
 	    .def_property("name", &Task::name, &Task::setName, "str: name of the task displayed e.g. in rviz")
+	    .def_property("num_threads", &Task::numThreads, &Task::setNumThreads,
+	                  "int: number of threads used to compute independent stages concurrently")
 
 	    .def("loadRobotModel", &Task::loadRobotModel, "node"_a, "robot_description"_a = "robot_description",
 	         "Load robot model from given ROS parameter")
@@ -425,6 +433,10 @@ void export_core(pybind11::module& m) {
 	    .def("enableIntrospection", &Task::enableIntrospection, "enabled"_a = true,
 	         "Enable publishing intermediate results for inspection in ``rviz``")
 	    .def("clear", &Task::clear, "Reset the stage task (and all its stages)")
+	    .def("collectPrunedBranches", &Task::collectPrunedBranches,
+	         "Release planning scenes and trajectories of branches pruned while collection was enabled")
+	    .def("setCollectPrunedBranches", &Task::setCollectPrunedBranches, "enable"_a = true,
+	         "Record pruned states and collect their branches after each planning iteration")
 	    .def(
 	        "add",
 	        [](Task& t, const py::args& args) {
@@ -192,6 +192,7 @@ void export_stages(pybind11::module& m) {
 			(defines cost of the inverse kinematics).
 		)")
 	    .property<uint32_t>("max_ik_solutions", "uint: max number of solutions to return")
+	    .property<uint32_t>("num_ik_threads", "uint: number of threads searching for IK solutions concurrently")
 	    .property<bool>("ignore_collisions", R"(
 			bool: Specify if collisions with other members of
 			the planning scene are allowed.
@@ -333,6 +334,9 @@ void export_stages(pybind11::module& m) {
 
 			.. _Constraints: https://docs.ros.org/en/api/moveit_msgs/html/msg/Constraints.html
 		)")
+	    .property<uint32_t>("max_concurrent_pairs", "uint: Number of pending state pairs planned concurrently")
+	    .def_property("max_pending_requests", &Connect::maxPendingRequests, &Connect::setMaxPendingRequests,
+	                  "int: Number of asynchronous planning requests kept in flight (0: plan synchronously)")
 	    .def(py::init<const std::string&, const Connect::GroupPlannerVector&>(),
 	         "name"_a = std::string("connect"), "planners"_a);
 
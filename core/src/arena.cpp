@@ -0,0 +1,144 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/task_constructor/arena.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace moveit {
+namespace task_constructor {
+
+struct Arena::Chunk
+{
+	Chunk* next;
+	const std::size_t size;  // total size of the chunk, including this header
+	std::atomic<std::size_t> used;  // offset of the first free byte w.r.t. this
+
+	Chunk(Chunk* next, std::size_t size) : next(next), size(size), used(sizeof(Chunk)) {}
+
+	/// bump-allocate bytes with given alignment, nullptr if the chunk is exhausted
+	void* allocate(std::size_t bytes, std::size_t alignment) {
+		const auto base = reinterpret_cast<std::uintptr_t>(this);
+		std::size_t offset = used.load(std::memory_order_relaxed);
+		while (true) {
+			// alignment is a power of two
+			const std::uintptr_t p = (base + offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+			const std::size_t end = p - base + bytes;
+			if (end > size)
+				return nullptr;
+			// on failure, offset is updated to the current value
+			if (used.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+				return reinterpret_cast<void*>(p);
+		}
+	}
+};
+
+Arena::Arena(std::size_t chunk_size, std::pmr::memory_resource* upstream, std::size_t max_reserved)
+  : chunk_size_(std::max(chunk_size, 2 * sizeof(Chunk))), max_reserved_(max_reserved), upstream_(upstream) {}
+
+Arena::~Arena() {
+	while (chunks_) {
+		Chunk* chunk = chunks_;
+		chunks_ = chunk->next;
+		const std::size_t size = chunk->size;
+		chunk->~Chunk();
+		upstream_->deallocate(chunk, size, alignof(std::max_align_t));
+	}
+}
+
+Arena::Chunk* Arena::acquireChunk(std::size_t bytes, std::size_t alignment) {
+	const std::size_t size = std::max(chunk_size_, sizeof(Chunk) + alignment + bytes);
+	if (reserved_ + size > max_reserved_)
+		return nullptr;
+	chunks_ = new (upstream_->allocate(size, alignof(std::max_align_t))) Chunk(chunks_, size);
+	chunk_ranges_.emplace(reinterpret_cast<std::uintptr_t>(chunks_), size);
+	reserved_ += size;
+	++num_chunks_;
+	return chunks_;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+	Chunk* chunk = current_.load(std::memory_order_acquire);
+	void* p = chunk ? chunk->allocate(bytes, alignment) : nullptr;
+	if (!p) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		// another thread might have acquired a new chunk meanwhile
+		chunk = current_.load(std::memory_order_acquire);
+		p = chunk ? chunk->allocate(bytes, alignment) : nullptr;
+		if (!p) {
+			Chunk* fresh = acquireChunk(bytes, alignment);
+			if (!fresh) {  // arena is exhausted: serve from upstream, which will receive the memory back
+				overflown_.store(true, std::memory_order_relaxed);
+				p = upstream_->allocate(bytes, alignment);
+				overflow_bytes_ += bytes;
+				allocated_ += bytes;
+				return p;
+			}
+			p = fresh->allocate(bytes, alignment);
+			// oversized requests get a dedicated chunk, while the current one continues to serve small requests
+			if (!chunk || fresh->size == chunk_size_)
+				current_.store(fresh, std::memory_order_release);
+		}
+	}
+	allocated_ += bytes;
+	return p;
+}
+
+bool Arena::ownsChunkMemory(const void* p) const {
+	const auto address = reinterpret_cast<std::uintptr_t>(p);
+	auto it = chunk_ranges_.upper_bound(address);
+	if (it == chunk_ranges_.begin())
+		return false;
+	--it;
+	return address < it->first + it->second;
+}
+
+void Arena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+	allocated_ -= bytes;
+	// overflown_ was set before handing out any memory from upstream
+	if (!overflown_.load(std::memory_order_relaxed))
+		return;  // memory is not reused, but released with the whole arena
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (ownsChunkMemory(p))
+		return;
+	lock.unlock();
+	overflow_bytes_ -= bytes;
+	upstream_->deallocate(p, bytes, alignment);
+}
+
+}  // namespace task_constructor
+}  // namespace moveit
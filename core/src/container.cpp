@@ -38,6 +38,7 @@
 #include <moveit/task_constructor/introspection.h>
 #include <moveit/task_constructor/merge.h>
 #include <moveit/task_constructor/fmt_p.h>
+#include <moveit/task_constructor/thread_pool.h>
 #include <moveit/planning_scene/planning_scene.hpp>
 #include <moveit/trajectory_processing/time_optimal_trajectory_generation.hpp>
 
@@ -46,6 +47,7 @@
 
 #include <memory>
 #include <iostream>
+#include <unordered_set>
 #include <algorithm>
 #include <boost/range/adaptor/reversed.hpp>
 #include <functional>
@@ -86,12 +88,10 @@ static void printChildrenInterfaces(const ContainerBasePrivate& container, bool
 ContainerBasePrivate::ContainerBasePrivate(ContainerBase* me, const std::string& name)
   : StagePrivate(me, name)
   , required_interface_(UNKNOWN)
-  , pending_backward_(new Interface)
-  , pending_forward_(new Interface) {}
+  , pending_backward_(new Interface(Interface::NotifyFunction(), Interface::FIFO))
+  , pending_forward_(new Interface(Interface::NotifyFunction(), Interface::FIFO)) {}
 
 ContainerBasePrivate& ContainerBasePrivate::operator=(ContainerBasePrivate&& other) {
-	assert(internal_external_.empty() && other.internal_external_.empty());
-
 	// move StagePrivate members
 	this->StagePrivate::operator=(std::move(other));
 
@@ -163,6 +163,108 @@ void ContainerBasePrivate::compute() {
 	static_cast<ContainerBase*>(me_)->compute();
 }
 
+std::exception_ptr ContainerBasePrivate::recordConcurrently(const std::vector<std::function<void()>>& jobs,
+                                                            std::vector<CommitBuffer>& buffers) {
+	assert(threadPool() && !jobs.empty());
+	buffers.resize(jobs.size());
+	std::vector<std::future<void>> futures;
+	futures.reserve(jobs.size() - 1);
+	for (size_t i = 1; i < jobs.size(); ++i)
+		futures.push_back(threadPool()->submit([&job = jobs[i], &buffer = buffers[i]]() { buffer.record(job); }));
+
+	// use the calling thread for the first job
+	std::exception_ptr error;
+	try {
+		buffers[0].record(jobs[0]);
+	} catch (...) {
+		error = std::current_exception();
+	}
+	for (auto& future : futures) {
+		try {
+			future.get();
+		} catch (...) {
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	return error;
+}
+
+void ContainerBasePrivate::computeConcurrently(const std::vector<StagePrivate*>& children) {
+	if (!threadPool() || children.size() < 2) {  // nothing to parallelize
+		for (StagePrivate* child : children)
+			child->runCompute();
+		return;
+	}
+
+	std::vector<std::function<void()>> jobs;
+	jobs.reserve(children.size());
+	for (StagePrivate* child : children)
+		jobs.emplace_back([child]() { child->runCompute(); });
+
+	std::vector<CommitBuffer> buffers;
+	std::exception_ptr error = recordConcurrently(jobs, buffers);
+
+	// serialized, deterministic commit of all results
+	for (CommitBuffer& buffer : buffers)
+		buffer.replay();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+std::vector<StagePrivate*> ContainerBasePrivate::scheduledChildren() const {
+	SchedulerPolicy::Candidates candidates;
+	for (const auto& stage : children()) {
+		if (stage->pimpl()->canCompute())
+			candidates.emplace_back(*stage);
+	}
+	if (const auto& policy = static_cast<const ContainerBase*>(me_)->schedulerPolicy())
+		policy->schedule(candidates);
+
+	std::vector<StagePrivate*> result;
+	result.reserve(candidates.size());
+	for (const SchedulingCandidate& candidate : candidates)
+		result.push_back(const_cast<StagePrivate*>(candidate.stage->pimpl()));
+	return result;
+}
+
+void ContainerBasePrivate::computeChildren(const std::vector<StagePrivate*>& children) {
+	if (!threadPool()) {
+		// computing a child might have exhausted its successors: check again
+		for (StagePrivate* child : children) {
+			if (child->canCompute())
+				child->runCompute();
+		}
+		return;
+	}
+
+	// Compute all children supporting it concurrently. As their commits are deferred,
+	// they cannot interfere with each other. Remaining children (containers) are computed afterwards,
+	// sequentially, but internally can dispatch their own children to the thread pool again.
+	std::vector<StagePrivate*> concurrent;
+	std::vector<StagePrivate*> sequential;
+	for (StagePrivate* child : children)
+		(child->canComputeConcurrently() ? concurrent : sequential).push_back(child);
+	computeConcurrently(concurrent);
+	for (StagePrivate* child : sequential) {
+		if (child->canCompute())
+			child->runCompute();
+	}
+}
+
+InterfaceState::Priority ContainerBasePrivate::pendingPriority() const {
+	InterfaceState::Priority best = noPendingPriority();
+	for (const auto& stage : children()) {
+		if (!stage->pimpl()->canCompute())
+			continue;
+		InterfaceState::Priority prio = stage->pimpl()->pendingPriority();
+		if (prio < best)
+			best = prio;
+	}
+	return best;
+}
+
 template <Interface::Direction dir>
 void ContainerBasePrivate::setStatus(const Stage* creator, const InterfaceState* source, const InterfaceState* target,
                                      InterfaceState::Status status) {
@@ -180,7 +282,8 @@ void ContainerBasePrivate::setStatus(const Stage* creator, const InterfaceState*
 	// Skip disabling the state, if there are alternative enabled solutions
 	if (status != InterfaceState::ENABLED) {
 		auto solution_is_enabled = [](auto&& solution) {
-			return state<opposite<dir>()>(*solution)->priority().enabled();
+			// failures (e.g. solutions invalidated by a scene update) don't provide an alternative path
+			return !solution->isFailure() && state<opposite<dir>()>(*solution)->priority().enabled();
 		};
 		const auto& alternatives = trajectories<opposite<dir>()>(*target);
 		auto alternative_path = std::find_if(alternatives.cbegin(), alternatives.cend(), solution_is_enabled);
@@ -190,19 +293,20 @@ void ContainerBasePrivate::setStatus(const Stage* creator, const InterfaceState*
 
 	// actually enable/disable the state
 	const_cast<InterfaceState*>(target)->updateStatus(status);
+	if (target->priority().status() == InterfaceState::Status::PRUNED && collectingPruned())
+		pruned_states_.push_back(target);  // candidate for collectPrunedBranches()
 
 	// if possible (i.e. if target has an external counterpart), escalate setStatus to external interface
 	if (parent() && trajectories<dir>(*target).empty()) {
 		// TODO: This was coded with SerialContainer in mind. Not sure, it works for ParallelContainers
-		auto external{ internalToExternalMap().find(target) };
-		if (external != internalToExternalMap().end()) {  // do we have an external state?
+		if (const InterfaceState* external = externalState(target)) {  // do we have an external state?
 			// only escalate if there is no other *enabled* internal state connected to the same external one
-			// all internal states linked to external
-			auto internals{ externalToInternalMap().equal_range(external->get<EXTERNAL>()) };
-			auto is_enabled = [](const auto& ext_int_pair) { return ext_int_pair.second->priority().enabled(); };
-			auto other_path{ std::find_if(internals.first, internals.second, is_enabled) };
-			if (other_path == internals.second)
-				parent()->pimpl()->setStatus<dir>(nullptr, nullptr, external->get<EXTERNAL>(), status);
+			bool other_path = false;
+			forEachInternalState(external, [&other_path](const InterfaceState* internal) {
+				other_path = other_path || internal->priority().enabled();
+			});
+			if (!other_path)
+				parent()->pimpl()->setStatus<dir>(nullptr, nullptr, external, status);
 			return;
 		}
 	}
@@ -220,6 +324,100 @@ void ContainerBasePrivate::setStatus(const Stage* creator, const InterfaceState*
 		setStatus<dir>(successor->creator(), target, state<dir>(*successor), status);
 }
 
+std::size_t ContainerBasePrivate::collectPrunedBranches() {
+	// consider states of both interfaces of Connecting stages as connected
+	OppositeInterfaces opposites;
+	static_cast<ContainerBase*>(me_)->traverseRecursively([&opposites](const Stage& stage, unsigned int /*depth*/) {
+		if (const auto* connecting = dynamic_cast<const ConnectingPrivate*>(stage.pimpl())) {
+			opposites[connecting->starts().get()] = connecting->ends().get();
+			opposites[connecting->ends().get()] = connecting->starts().get();
+		}
+		return true;
+	});
+	std::unordered_set<const InterfaceState*> alive;
+	return collectPrunedBranches(opposites, alive);
+}
+
+std::size_t ContainerBasePrivate::collectPrunedBranches(const OppositeInterfaces& opposites,
+                                                        std::unordered_set<const InterfaceState*>& alive) {
+	std::size_t released = 0;
+	std::vector<const InterfaceState*> stack;
+	std::unordered_set<const InterfaceState*> branch;  // all states of the current branch
+	std::vector<const SolutionBase*> solutions;  // all solutions of the current branch
+
+	for (const InterfaceState* start : pruned_states_) {
+		if (!start->scene() || start->priority().status() != InterfaceState::Status::PRUNED)
+			continue;  // already released or re-enabled
+		if (alive.count(start))
+			continue;  // part of a branch already found alive in this pass
+
+		// traverse the whole branch, stopping at the first state that is not PRUNED
+		bool dead = true;
+		branch.clear();
+		solutions.clear();
+		stack.assign(1, start);
+		branch.insert(start);
+		auto visit = [&](const InterfaceState* s) {
+			if (s && branch.insert(s).second)
+				stack.push_back(s);
+		};
+		// states only created for a failure were never spawned: they are released along, but don't keep the branch alive
+		auto visit_along = [&](const SolutionBase* solution, const InterfaceState* s) {
+			if (solution->isFailure() && !s->owner() &&
+			    s->incomingTrajectories().size() + s->outgoingTrajectories().size() == 1)
+				branch.insert(s);
+			else
+				visit(s);
+		};
+		while (!stack.empty()) {
+			const InterfaceState* s = stack.back();
+			stack.pop_back();
+			// all other non-pruned states are alive, including those fetched from their interface for a computation
+			if (s->priority().status() != InterfaceState::Status::PRUNED || alive.count(s)) {
+				dead = false;
+				break;
+			}
+			auto opposite = opposites.find(s->owner());
+			if (opposite != opposites.end())
+				for (const InterfaceState* o : *opposite->second)
+					visit(o);
+			for (const SolutionBase* solution : s->incomingTrajectories()) {
+				solutions.push_back(solution);
+				visit_along(solution, solution->start());
+			}
+			for (const SolutionBase* solution : s->outgoingTrajectories()) {
+				solutions.push_back(solution);
+				visit_along(solution, solution->end());
+			}
+			visit(externalState(s));
+			forEachInternalState(s, visit);
+		}
+		if (!dead) {  // remember visited states to not traverse the alive branch again
+			alive.insert(branch.begin(), branch.end());
+			continue;
+		}
+
+		for (const InterfaceState* s : branch) {
+			if (s->scene())
+				++released;
+			const_cast<InterfaceState*>(s)->scene_.reset();
+		}
+		for (const SolutionBase* solution : solutions) {
+			if (auto* sub = dynamic_cast<const SubTrajectory*>(solution))
+				const_cast<SubTrajectory*>(sub)->setTrajectory(robot_trajectory::RobotTrajectoryPtr());
+			const_cast<SolutionBase*>(solution)->markers().clear();
+		}
+	}
+	pruned_states_.clear();
+
+	// recursively collect in child containers
+	for (const auto& child : children()) {
+		if (auto* container = dynamic_cast<ContainerBasePrivate*>(child->pimpl()))
+			released += container->collectPrunedBranches(opposites, alive);
+	}
+	return released;
+}
+
 // recursively update state priorities along solution path
 template <Interface::Direction dir>
 inline void updateStatePrios(const InterfaceState& s, const InterfaceState::Priority& prio) {
@@ -257,19 +455,70 @@ void ContainerBasePrivate::onNewFailure(const Stage& child, const InterfaceState
 	// printChildrenInterfaces(*this, false, child);
 }
 
+void ContainerBasePrivate::onDroppedState(Interface::Direction dir, const InterfaceState* state) {
+	// the branch leading to the dropped state is pruned like for a failure on that state (irrespective of pruning())
+	if (dir == Interface::FORWARD)
+		setStatus<Interface::BACKWARD>(nullptr, nullptr, state, InterfaceState::Status::PRUNED);
+	else
+		setStatus<Interface::FORWARD>(nullptr, nullptr, state, InterfaceState::Status::PRUNED);
+}
+
+std::size_t ContainerBasePrivate::invalidateSolutions(const std::function<bool(const SolutionBase&)>& predicate,
+                                                     const std::string& comment) {
+	// mark all invalid solutions as failures first: setStatus() ignores failures as alternative paths
+	std::vector<std::pair<StagePrivate*, SolutionBaseConstPtr>> invalidated;
+	static_cast<ContainerBase*>(me_)->traverseRecursively([&](const Stage& stage, unsigned int /*depth*/) {
+		auto* impl = const_cast<StagePrivate*>(stage.pimpl());
+		for (SolutionBaseConstPtr& solution : impl->discardSolutions(predicate, comment))
+			invalidated.emplace_back(impl, std::move(solution));
+		return true;
+	});
+	// ... and only then prune their states
+	for (const auto& item : invalidated)
+		if (ContainerBase* parent = item.first->parent())
+			parent->pimpl()->onInvalidatedSolution(*item.first->me(), *item.second);
+	return invalidated.size();
+}
+
+void ContainerBasePrivate::updateScenes(const SceneUpdate& update) {
+	auto update_state = [&update](InterfaceState& state) {
+		if (state.scene_)  // scenes of pruned branches might be released already
+			state.scene_ = update(state.scene_);
+	};
+	static_cast<ContainerBase*>(me_)->traverseRecursively([&update_state](const Stage& stage, unsigned int /*depth*/) {
+		const_cast<StagePrivate*>(stage.pimpl())->forEachState(update_state);
+		return true;
+	});
+}
+
+void ContainerBasePrivate::pruneCreatedStates(const Stage& child, const SolutionBase& solution) {
+	const InterfaceFlags flags = child.pimpl()->interfaceFlags();
+	if (flags & WRITES_PREV_END)
+		setStatus<Interface::BACKWARD>(nullptr, nullptr, solution.start(), InterfaceState::Status::PRUNED);
+	if (flags & WRITES_NEXT_START)
+		setStatus<Interface::FORWARD>(nullptr, nullptr, solution.end(), InterfaceState::Status::PRUNED);
+}
+
+void ContainerBasePrivate::onInvalidatedSolution(const Stage& child, const SolutionBase& solution) {
+	pruneCreatedStates(child, solution);
+	// states the solution originated from are handled like for any other failure
+	onNewFailure(child, solution.start(), solution.end());
+}
+
 template <Interface::Direction dir>
 void ContainerBasePrivate::copyState(Interface::iterator external, const InterfacePtr& target,
                                      Interface::UpdateFlags updated) {
 	if (updated) {
 		auto prio = external->priority();
-		auto internals = externalToInternalMap().equal_range(&*external);
 
 		if (updated.testFlag(Interface::Update::STATUS)) {  // propagate external status updates to internal copies
-			for (auto& i = internals.first; i != internals.second; ++i)
-				setStatus<dir>(nullptr, nullptr, i->second, prio.status());
+			forEachInternalState(&*external, [this, &prio](const InterfaceState* internal) {
+				setStatus<dir>(nullptr, nullptr, internal, prio.status());
+			});
 		} else if (updated.testFlag(Interface::Update::PRIORITY)) {
-			for (auto& i = internals.first; i != internals.second; ++i)
-				updateStatePrios<opposite<dir>()>(*i->second, prio);
+			forEachInternalState(&*external, [&prio](const InterfaceState* internal) {
+				updateStatePrios<opposite<dir>()>(*internal, prio);
+			});
 		} else
 			assert(false);  // Expecting either STATUS or PRIORITY updates, not both!
 		return;
@@ -278,7 +527,7 @@ void ContainerBasePrivate::copyState(Interface::iterator external, const Interfa
 	auto internal = states_.insert(states_.end(), InterfaceState(*external));
 	target->add(*internal);
 	// and remember the mapping between them
-	internalToExternalMap().insert(std::make_pair(&*internal, &*external));
+	linkStates(&*internal, &*external);
 }
 
 void ContainerBasePrivate::copyState(Interface::Direction dir, Interface::iterator external, const InterfacePtr& target,
@@ -291,16 +540,21 @@ void ContainerBasePrivate::copyState(Interface::Direction dir, Interface::iterat
 
 void ContainerBasePrivate::liftSolution(const SolutionBasePtr& solution, const InterfaceState* internal_from,
                                         const InterfaceState* internal_to) {
+	if (CommitBuffer* buffer = CommitBuffer::active()) {
+		buffer->defer(
+		    [this, solution, internal_from, internal_to]() { liftSolution(solution, internal_from, internal_to); });
+		return;
+	}
+
 	computeCost(*internal_from, *internal_to, *solution);
 
 	// map internal to external states
 	auto find_or_create_external = [this](const InterfaceState* internal, bool& created) -> InterfaceState* {
-		auto it = internalToExternalMap().find(internal);
-		if (it != internalToExternalMap().end())
-			return const_cast<InterfaceState*>(it->second);
+		if (InterfaceState* external = externalState(internal))
+			return external;
 
 		InterfaceState* external = &*states_.insert(states_.end(), InterfaceState(*internal));
-		internalToExternalMap().insert(std::make_pair(internal, external));
+		linkStates(const_cast<InterfaceState*>(internal), external);
 		created = true;
 		return external;
 	};
@@ -328,6 +582,9 @@ void ContainerBasePrivate::liftSolution(const SolutionBasePtr& solution, const I
 ContainerBase::ContainerBase(ContainerBasePrivate* impl) : Stage(impl) {
 	auto& p = properties();
 	p.declare<bool>("pruning", false, std::string("enable pruning?")).configureInitFrom(Stage::PARENT, "pruning");
+	p.declare<SchedulerPolicyConstPtr>("scheduler", SchedulerPolicyConstPtr(),
+	                                   "policy selecting the children to compute in each step")
+	    .configureInitFrom(Stage::PARENT, "scheduler");
 }
 
 size_t ContainerBase::numChildren() const {
@@ -412,8 +669,8 @@ void ContainerBase::reset() {
 	// clear buffer interfaces
 	impl->pending_backward_->clear();
 	impl->pending_forward_->clear();
-	// ... and state mapping
-	impl->internalToExternalMap().clear();
+	impl->pruned_states_.clear();
+	// (links between internal and external states are released along with the states)
 
 	// interfaces depend on children which might change
 	impl->required_interface_ = UNKNOWN;
@@ -482,7 +739,12 @@ std::ostream& operator<<(std::ostream& os, const ContainerBase& container) {
 template <Interface::Direction dir>
 struct SolutionCollector
 {
-	SolutionCollector(size_t max_depth, const SolutionBase& start) : max_depth(max_depth) {
+	/// decide whether a state can reach the container's start/end with the given number of remaining solutions
+	using Filter = std::function<bool(const InterfaceState&, size_t)>;
+
+	/// if a filter is given, only complete solution sequences (of max_depth) are collected
+	SolutionCollector(size_t max_depth, const SolutionBase& start, Filter filter = Filter())
+	  : max_depth(max_depth), filter(std::move(filter)) {
 		trace.reserve(max_depth);
 		traverse(start, InterfaceState::Priority(0, 0.0));
 		assert(trace.empty());
@@ -493,11 +755,15 @@ struct SolutionCollector
 		if (next.empty()) {  // when reaching the end, add the trace to solutions
 			assert(prio.depth() == trace.size());
 			assert(prio.depth() <= max_depth);
-			solutions.emplace_back(std::make_pair(trace, prio));
+			if (!filter || prio.depth() == max_depth)
+				solutions.emplace_back(std::make_pair(trace, prio));
 		} else {
 			for (SolutionBase* successor : next) {
 				if (successor->isFailure())
 					continue;  // skip failures
+				if (filter &&
+				    (trace.size() >= max_depth || !filter(*state<dir>(*successor), max_depth - trace.size() - 1)))
+					continue;  // skip branches not reaching the container's start/end
 				trace.push_back(successor);
 				traverse(*successor, prio + InterfaceState::Priority(1, successor->cost()));
 				trace.pop_back();
@@ -508,6 +774,7 @@ struct SolutionCollector
 	using SolutionCostPairs = std::list<std::pair<SolutionSequence::container_type, InterfaceState::Priority>>;
 	SolutionCostPairs solutions;
 	const size_t max_depth;
+	const Filter filter;
 	SolutionSequence::container_type trace;
 };
 
@@ -530,45 +797,209 @@ void SerialContainer::onNewSolution(const SolutionBase& current) {
 	assert(num_before < children.size());  // creator should be one of our children
 	num_after = children.size() - 1 - num_before;
 
+	const bool lazy = properties().get<bool>("lazy_enumeration");
+	const bool incremental = lazy || properties().get<bool>("incremental_assembly");
+	if (lazy)  // remember arrival order to enumerate each full path only once: with its newest solution
+		impl->arrival_.emplace(&current, impl->arrival_.size());
+	if (incremental) {
+		// update state priorities from the best partial paths, without walking the solution graph
+		impl->updatePathPriorities(current);
+		// only enumerate solution paths if current is part of a full path connecting start to end
+		if (impl->pathPriorities(*current.start()).backward.depth() != num_before ||
+		    impl->pathPriorities(*current.end()).forward.depth() != num_after)
+			return;
+		if (lazy) {  // defer enumeration until solutions are requested via compute()
+			impl->addCandidate(current, num_before);
+			return;
+		}
+	}
+	auto reaches_start = [impl](const InterfaceState& s, size_t remaining) {
+		return impl->pathPriorities(s).backward.depth() == remaining;
+	};
+	auto reaches_end = [impl](const InterfaceState& s, size_t remaining) {
+		return impl->pathPriorities(s).forward.depth() == remaining;
+	};
+
 	// find all incoming and outgoing solution paths originating from current solution
-	SolutionCollector<Interface::BACKWARD> incoming(num_before, current);
-	SolutionCollector<Interface::FORWARD> outgoing(num_after, current);
+	// (if assembling incrementally, only those reaching the container's start resp. end)
+	using Incoming = SolutionCollector<Interface::BACKWARD>;
+	using Outgoing = SolutionCollector<Interface::FORWARD>;
+	Incoming incoming(num_before, current, incremental ? Incoming::Filter(reaches_start) : Incoming::Filter());
+	Outgoing outgoing(num_after, current, incremental ? Outgoing::Filter(reaches_end) : Outgoing::Filter());
+
+	// segments shared by all solutions with the same outgoing path (created on demand)
+	std::vector<SolutionSequence::Segment> suffixes(outgoing.solutions.size());
 
 	// collect (and lift) all solutions spanning from start to end of this container
 	for (auto& in : incoming.solutions) {
+		// segment shared by all solutions with the same incoming path (created on demand)
+		SolutionSequence::Segment prefix;
+		auto suffix = suffixes.begin();
 		for (auto& out : outgoing.solutions) {
 			InterfaceState::Priority prio = in.second + InterfaceState::Priority(1u, current.cost()) + out.second;
 			assert(prio.enabled());
 			// found a complete solution path connecting start to end?
 			if (prio.depth() == children.size()) {
-				SolutionSequence::container_type seq;
-				seq.reserve(children.size());
-				// insert incoming solutions in reverse order
-				seq.insert(seq.end(), in.first.rbegin(), in.first.rend());
-				// insert current solution
-				seq.push_back(&current);
-				// insert outgoing solutions in normal order
-				seq.insert(seq.end(), out.first.begin(), out.first.end());
+				if (!prefix) {
+					SolutionSequence::container_type seq;
+					seq.reserve(in.first.size() + 1);
+					// insert incoming solutions in reverse order
+					seq.insert(seq.end(), in.first.rbegin(), in.first.rend());
+					// insert current solution
+					seq.push_back(&current);
+					prefix = std::make_shared<const SolutionSequence::container_type>(std::move(seq));
+				}
+				// outgoing solutions in normal order
+				if (!*suffix)
+					*suffix = std::make_shared<const SolutionSequence::container_type>(out.first);
 				// create SolutionSequence and lift it to external interface
-				auto solution = std::make_shared<SolutionSequence>(std::move(seq), prio.cost(), this);
+				auto solution =
+				    makeShared<SolutionSequence>(SolutionSequence::Segments{ prefix, *suffix }, prio.cost(), this);
 				impl->liftSolution(solution, solution->internalStart(), solution->internalEnd());
 			}
-			if (prio.depth() > 1) {
+			if (prio.depth() > 1 && !incremental) {
 				// update state priorities along the whole partial solution path
 				updateStatePrios<Interface::BACKWARD>(*current.start(), prio);
 				updateStatePrios<Interface::FORWARD>(*current.end(), prio);
 			}
+			++suffix;
 		}
 	}
 	// printChildrenInterfaces(*this->pimpl(), true, *current.creator());
 }
 
-SerialContainer::SerialContainer(SerialContainerPrivate* impl) : ContainerBase(impl) {}
+SerialContainer::SerialContainer(SerialContainerPrivate* impl) : ContainerBase(impl) {
+	auto& p = properties();
+	p.declare<bool>("incremental_assembly", false, "assemble full solutions from incrementally updated path priorities")
+	    .configureInitFrom(Stage::PARENT, "incremental_assembly");
+	p.declare<bool>("lazy_enumeration", false, "lazily lift full solutions in increasing cost order")
+	    .configureInitFrom(Stage::PARENT, "lazy_enumeration");
+}
 SerialContainer::SerialContainer(const std::string& name) : SerialContainer(new SerialContainerPrivate(this, name)) {}
 
+void SerialContainer::reset() {
+	ContainerBase::reset();
+	pimpl()->reset();
+}
+
 SerialContainerPrivate::SerialContainerPrivate(SerialContainer* me, const std::string& name)
   : ContainerBasePrivate(me, name) {}
 
+void SerialContainerPrivate::reset() {
+	path_priorities_.clear();
+	candidates_ = decltype(candidates_)();
+	num_candidates_ = 0;
+	arrival_.clear();
+}
+
+const SerialContainerPrivate::PathPriorities& SerialContainerPrivate::pathPriorities(const InterfaceState& s) const {
+	static const PathPriorities NONE;
+	auto it = path_priorities_.find(&s);
+	return it == path_priorities_.end() ? NONE : it->second;
+}
+
+void SerialContainerPrivate::updatePathPriorities(const SolutionBase& current) {
+	const InterfaceState::Priority prio(1u, current.cost());
+	// copy path priorities of both ends, as they are modified during propagation
+	const PathPriorities start = pathPriorities(*current.start());
+	const PathPriorities end = pathPriorities(*current.end());
+	// current extends the paths toward the container's end of all states before current.start() ...
+	propagatePathPriority<Interface::FORWARD>(*current.start(), prio + end.forward);
+	// ... and the paths toward the container's start of all states after current.end()
+	propagatePathPriority<Interface::BACKWARD>(*current.end(), start.backward + prio);
+}
+
+// update path priority of s toward the container's start/end (as determined by dir)
+// and propagate improvements to the states reaching s from the opposite direction
+template <Interface::Direction dir>
+void SerialContainerPrivate::propagatePathPriority(const InterfaceState& s, const InterfaceState::Priority& prio) {
+	PathPriorities& paths = path_priorities_[&s];
+	InterfaceState::Priority& best = (dir == Interface::FORWARD) ? paths.forward : paths.backward;
+	if (!(prio < best))
+		return;  // no improvement
+	best = prio;
+	updateStatePriority(s, paths);
+
+	for (const SolutionBase* predecessor : trajectories<opposite<dir>()>(s)) {
+		if (predecessor->isFailure())
+			continue;  // skip failures
+		propagatePathPriority<dir>(*state<opposite<dir>()>(*predecessor),
+		                           InterfaceState::Priority(1u, predecessor->cost()) + prio);
+	}
+}
+
+void SerialContainerPrivate::updateStatePriority(const InterfaceState& s, const PathPriorities& paths) {
+	// best partial solution path passing through s
+	InterfaceState::Priority prio = paths.backward + paths.forward;
+	if (prio.depth() > 1)
+		const_cast<InterfaceState&>(s).updatePriority(InterfaceState::Priority(prio, s.priority().status()));
+}
+
+void SerialContainerPrivate::addCandidate(const SolutionBase& current, size_t num_before) {
+	PathCandidate candidate;
+	candidate.seq.reserve(children().size());
+	candidate.seq.push_back(&current);
+	candidate.cost = current.cost();
+	candidate.newest = arrival_.at(&current);
+	candidate.missing_before = num_before;
+	pushCandidate(std::move(candidate));
+}
+
+void SerialContainerPrivate::pushCandidate(PathCandidate&& candidate) {
+	// best costs to reach the container's start and end are a lower bound for the cost of all full paths
+	candidate.key = candidate.cost + pathPriorities(*candidate.seq.front()->start()).backward.cost() +
+	                pathPriorities(*candidate.seq.back()->end()).forward.cost();
+	candidate.id = num_candidates_++;
+	candidates_.push(std::move(candidate));
+}
+
+template <Interface::Direction dir>
+void SerialContainerPrivate::extendCandidate(const PathCandidate& candidate) {
+	const bool backward = (dir == Interface::BACKWARD);
+	const InterfaceState& s = backward ? *candidate.seq.front()->start() : *candidate.seq.back()->end();
+	// number of solutions still required after the extension
+	const size_t remaining =
+	    backward ? candidate.missing_before - 1 : children().size() - candidate.seq.size() - 1;
+
+	for (const SolutionBase* next : trajectories<dir>(s)) {
+		if (next->isFailure())
+			continue;  // skip failures
+		auto it = arrival_.find(next);
+		if (it == arrival_.end() || it->second >= candidate.newest)
+			continue;  // paths including newer solutions are enumerated by those
+		const PathPriorities& paths = pathPriorities(*state<dir>(*next));
+		if ((backward ? paths.backward : paths.forward).depth() != remaining)
+			continue;  // cannot reach the container's start/end
+
+		PathCandidate extended(candidate);
+		if (backward) {
+			extended.seq.insert(extended.seq.begin(), next);
+			--extended.missing_before;
+		} else
+			extended.seq.push_back(next);
+		extended.cost += next->cost();
+		pushCandidate(std::move(extended));
+	}
+}
+
+bool SerialContainerPrivate::liftNextSolution() {
+	// best-first search: the first full path popped from the queue is the cheapest one
+	while (!candidates_.empty()) {
+		PathCandidate candidate = candidates_.top();
+		candidates_.pop();
+		if (candidate.missing_before > 0)
+			extendCandidate<Interface::BACKWARD>(candidate);
+		else if (candidate.seq.size() < children().size())
+			extendCandidate<Interface::FORWARD>(candidate);
+		else {
+			auto solution = me()->makeShared<SolutionSequence>(std::move(candidate.seq), candidate.cost, me());
+			liftSolution(solution, solution->internalStart(), solution->internalEnd());
+			return true;
+		}
+	}
+	return false;
+}
+
 void SerialContainerPrivate::connect(StagePrivate& stage1, StagePrivate& stage2) {
 	InterfaceFlags flags1 = stage1.requiredInterface();
 	InterfaceFlags flags2 = stage2.requiredInterface();
@@ -694,6 +1125,8 @@ void SerialContainerPrivate::validateConnectivity() const {
 }
 
 bool SerialContainer::canCompute() const {
+	if (pimpl()->hasCandidates())
+		return true;  // pending solutions to lift
 	for (const auto& stage : pimpl()->children()) {
 		if (stage->pimpl()->canCompute())
 			return true;
@@ -702,10 +1135,18 @@ bool SerialContainer::canCompute() const {
 }
 
 void SerialContainer::compute() {
-	for (const auto& stage : pimpl()->children()) {
-		if (stage->pimpl()->canCompute())
-			stage->pimpl()->runCompute();
+	auto impl = pimpl();
+	// with lazy enumeration, lift the next pending solution first
+	if (impl->liftNextSolution())
+		return;
+	if (!impl->threadPool() && !schedulerPolicy()) {
+		for (const auto& stage : impl->children()) {
+			if (stage->pimpl()->canCompute())
+				stage->pimpl()->runCompute();
+		}
+		return;
 	}
+	impl->computeChildren(impl->scheduledChildren());
 }
 
 ParallelContainerBasePrivate::ParallelContainerBasePrivate(ParallelContainerBase* me, const std::string& name)
@@ -795,25 +1236,29 @@ ParallelContainerBase::ParallelContainerBase(const std::string& name)
   : ParallelContainerBase(new ParallelContainerBasePrivate(this, name)) {}
 
 void ParallelContainerBase::liftSolution(const SolutionBase& solution, double cost, std::string comment) {
-	pimpl()->liftSolution(std::make_shared<WrappedSolution>(this, &solution, cost, std::move(comment)), solution.start(),
+	pimpl()->liftSolution(makeShared<WrappedSolution>(this, &solution, cost, std::move(comment)), solution.start(),
 	                      solution.end());
 }
 
 void ParallelContainerBase::spawn(InterfaceState&& state, SubTrajectory&& t) {
-	pimpl()->StagePrivate::spawn(std::move(state), std::make_shared<SubTrajectory>(std::move(t)));
+	pimpl()->StagePrivate::spawn(std::move(state), makeShared<SubTrajectory>(std::move(t)));
 }
 
 void ParallelContainerBase::sendForward(const InterfaceState& from, InterfaceState&& to, SubTrajectory&& t) {
-	pimpl()->StagePrivate::sendForward(from, std::move(to), std::make_shared<SubTrajectory>(std::move(t)));
+	pimpl()->StagePrivate::sendForward(from, std::move(to), makeShared<SubTrajectory>(std::move(t)));
 }
 
 void ParallelContainerBase::sendBackward(InterfaceState&& from, const InterfaceState& to, SubTrajectory&& t) {
-	pimpl()->StagePrivate::sendBackward(std::move(from), to, std::make_shared<SubTrajectory>(std::move(t)));
+	pimpl()->StagePrivate::sendBackward(std::move(from), to, makeShared<SubTrajectory>(std::move(t)));
 }
 
 WrapperBasePrivate::WrapperBasePrivate(WrapperBase* me, const std::string& name)
   : ParallelContainerBasePrivate(me, name) {}
 
+bool WrapperBasePrivate::canComputeConcurrently() const {
+	return !children().empty() && children().front()->pimpl()->canComputeConcurrently();
+}
+
 WrapperBase::WrapperBase(const std::string& name, Stage::pointer&& child)
   : WrapperBase(new WrapperBasePrivate(this, name), std::move(child)) {}
 
@@ -849,7 +1294,12 @@ bool Alternatives::canCompute() const {
 }
 
 void Alternatives::compute() {
-	for (const auto& stage : pimpl()->children()) {
+	auto impl = pimpl();
+	if (schedulerPolicy() || impl->threadPool()) {
+		impl->computeChildren(impl->scheduledChildren());
+		return;
+	}
+	for (const auto& stage : impl->children()) {
 		stage->pimpl()->runCompute();
 	}
 }
@@ -860,7 +1310,10 @@ void Alternatives::onNewSolution(const SolutionBase& s) {
 
 Fallbacks::Fallbacks(const std::string& name) : Fallbacks(new FallbacksPrivate(this, name)) {}
 
-Fallbacks::Fallbacks(FallbacksPrivate* impl) : ParallelContainerBase(impl) {}
+Fallbacks::Fallbacks(FallbacksPrivate* impl) : ParallelContainerBase(impl) {
+	properties().declare<uint32_t>("speculative_children", 0u,
+	                               "number of subsequent children to compute speculatively in parallel");
+}
 
 void Fallbacks::reset() {
 	ParallelContainerBase::reset();
@@ -928,6 +1381,11 @@ void FallbacksPrivate::onNewFailure(const Stage& child, const InterfaceState* /*
 	(void)child;
 }
 
+void FallbacksPrivate::onInvalidatedSolution(const Stage& child, const SolutionBase& solution) {
+	// As for onNewFailure(), don't prune the solution's origin, but only the states created by it
+	pruneCreatedStates(child, solution);
+}
+
 void FallbacksPrivateCommon::reset() {
 	current_ = children().begin();
 }
@@ -1001,6 +1459,75 @@ void FallbacksPrivatePropagator::onNewSolution(const SolutionBase& s) {
 	FallbacksPrivateCommon::onNewSolution(s);
 }
 
+void FallbacksPrivatePropagator::compute() {
+	std::vector<StagePrivate*> speculative;
+	if (threadPool() && (*current_)->pimpl()->canComputeConcurrently()) {
+		auto num = me()->properties().get<uint32_t>("speculative_children");
+		for (auto it = std::next(current_), end = children().end(); it != end && speculative.size() < num; ++it) {
+			StagePrivate* child = const_cast<StagePrivate*>((*it)->pimpl());
+			if (!child->canComputeConcurrently())
+				break;
+			speculative.push_back(child);
+		}
+	}
+	if (speculative.empty())
+		return FallbacksPrivateCommon::compute();
+
+	// feed the current job to the speculative children as well
+	std::vector<InterfaceState*> copies;
+	copies.reserve(speculative.size());
+	for (StagePrivate* child : speculative) {
+		copyState(dir_, job_, child->pullInterface(dir_), Interface::UpdateFlags());
+		copies.push_back(&states_.back());
+	}
+
+	// Compute the current and all speculative children on the job until exhaustion, deferring their commits
+	std::vector<StagePrivate*> computing{ const_cast<StagePrivate*>((*current_)->pimpl()) };
+	computing.insert(computing.end(), speculative.begin(), speculative.end());
+	std::vector<std::function<void()>> jobs;
+	jobs.reserve(computing.size());
+	auto exhaust = [](StagePrivate* child) {
+		return [child]() {
+			while (child->canCompute())
+				child->runCompute();
+		};
+	};
+	for (StagePrivate* child : computing)
+		jobs.push_back(exhaust(child));
+
+	std::vector<CommitBuffer> buffers;
+	std::exception_ptr error = recordConcurrently(jobs, buffers);
+
+	// Commit results in order of priority, until a child succeeded on the job.
+	std::size_t committed = 0;
+	while (committed < buffers.size()) {
+		buffers[committed].replay();
+		// Replaying might enable further computation, e.g. a wrapper processing its child's solutions
+		// only in its own compute(). Finish the job on the child before deciding about its success.
+		if (!error)
+			exhaust(computing[committed])();
+		++committed;
+		if (job_has_solutions_ || committed == buffers.size())
+			break;
+		nextChild();
+	}
+	// The current child is exhausted on the job now, such that canCompute() advances to the next job (or child)
+
+	// Results of all lower-priority children are discarded, as well as their copies of the job:
+	// unlinked from the job, they neither receive its updates nor block its pruning, and they are never expanded again
+	for (std::size_t i = committed; i < buffers.size(); ++i) {
+		InterfaceState* copy = copies[i - 1];  // buffers[0] belongs to the current child
+		unlinkState(copy);
+		if (dir_ == Interface::FORWARD)
+			setStatus<Interface::FORWARD>(nullptr, nullptr, copy, InterfaceState::Status::PRUNED);
+		else
+			setStatus<Interface::BACKWARD>(nullptr, nullptr, copy, InterfaceState::Status::PRUNED);
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
 bool FallbacksPrivatePropagator::nextJob() {
 	assert(current_ != children().end() && !(*current_)->pimpl()->canCompute());
 	const auto jobs = pullInterface(dir_);
@@ -1045,6 +1572,16 @@ FallbacksPrivateConnect::FallbacksPrivateConnect(FallbacksPrivate&& old) : Fallb
 	ends_ = std::make_shared<Interface>(std::bind(&FallbacksPrivateConnect::propagateStateUpdate<Interface::BACKWARD>,
 	                                              this, std::placeholders::_1, std::placeholders::_2));
 
+	// Subsequent children rank pairs of the first child's interface states, but only the first child is notified
+	// about their updates. Thus, let it re-rank the pending pairs of all children.
+	if (!children().empty()) {
+		auto first_con = static_cast<ConnectingPrivate*>(const_cast<StagePrivate*>(children().front()->pimpl()));
+		first_con->shared_pending_.clear();
+		for (auto it = std::next(children().begin()), end = children().end(); it != end; ++it)
+			first_con->shared_pending_.push_back(
+			    &static_cast<ConnectingPrivate*>(const_cast<StagePrivate*>((*it)->pimpl()))->pending);
+	}
+
 	FallbacksPrivateConnect::reset();
 }
 
@@ -1056,7 +1593,8 @@ template <Interface::Direction dir>
 void FallbacksPrivateConnect::propagateStateUpdate(Interface::iterator external, Interface::UpdateFlags updated) {
 	copyState<dir>(external, children().front()->pimpl()->pullInterface(dir), updated);
 	// As we use the Interface* from the first child for all children (we just populate their pending lists)
-	// there is no need to explicitly propagate state updates to other children.
+	// there is no need to explicitly propagate state updates to other children:
+	// the first child re-ranks their pending pairs as well (shared_pending_).
 }
 
 bool FallbacksPrivateConnect::canCompute() const {
@@ -1082,19 +1620,12 @@ void FallbacksPrivateConnect::onNewFailure(const Stage& child, const InterfaceSt
 	// ... thus we can use std::next(active_) to find the next child
 	auto next = std::next(active_);
 
-	// NOLINTNEXTLINE(readability-identifier-naming)
-	auto findIteratorFor = [](const InterfaceState* state, const Interface& interface) {
-		auto it = std::find(interface.begin(), interface.end(), state);
-		assert(it != interface.end());
-		return it;
-	};
-
 	if (next != children().end()) {  // pass job to next child
 		auto next_con = static_cast<ConnectingPrivate*>(const_cast<StagePrivate*>((*next)->pimpl()));
 		auto first_con = static_cast<const ConnectingPrivate*>(children().front()->pimpl());
-		auto from_it = findIteratorFor(from, *first_con->starts());
-		auto to_it = findIteratorFor(to, *first_con->ends());
-		next_con->pending.insert(std::make_pair(from_it, to_it));
+		auto from_it = first_con->starts()->find(from);
+		auto to_it = first_con->ends()->find(to);
+		next_con->pending.insert(ConnectingPrivate::StatePair(from_it, to_it));
 	} else  // or report failure to parent
 		parent()->pimpl()->onNewFailure(*me(), from, to);
 }
@@ -1180,10 +1711,9 @@ void MergerPrivate::onNewPropagateSolution(const SolutionBase& s) {
 	const InterfaceState* source_state = (dir == PROPAGATE_FORWARDS) ? s.start() : s.end();
 
 	// map to external source state that is shared by all children
-	auto source_it = internalToExternalMap().find(source_state);
+	const InterfaceState* external_source_state = externalState(source_state);
 	// internal->external mapping for source state should have been created
-	assert(source_it != internalToExternalMap().end());
-	const InterfaceState* external_source_state = &*source_it->second;
+	assert(external_source_state);
 
 	// retrieve (or create if necessary) the ChildSolutionMap for the given external source state
 	ChildSolutionMap& all_solutions =
@@ -1211,7 +1741,7 @@ void MergerPrivate::sendForward(SubTrajectory&& t, const InterfaceState* from) {
 	planning_scene::PlanningScenePtr to = from->scene()->diff();
 	if (t.trajectory() && !t.trajectory()->empty())
 		to->setCurrentState(t.trajectory()->getLastWayPoint());
-	StagePrivate::sendForward(*from, InterfaceState(to), std::make_shared<SubTrajectory>(std::move(t)));
+	StagePrivate::sendForward(*from, InterfaceState(to), me()->makeShared<SubTrajectory>(std::move(t)));
 }
 
 void MergerPrivate::sendBackward(SubTrajectory&& t, const InterfaceState* to) {
@@ -1219,7 +1749,7 @@ void MergerPrivate::sendBackward(SubTrajectory&& t, const InterfaceState* to) {
 	planning_scene::PlanningScenePtr from = to->scene()->diff();
 	if (t.trajectory() && !t.trajectory()->empty())
 		from->setCurrentState(t.trajectory()->getFirstWayPoint());
-	StagePrivate::sendBackward(InterfaceState(from), *to, std::make_shared<SubTrajectory>(std::move(t)));
+	StagePrivate::sendBackward(InterfaceState(from), *to, me()->makeShared<SubTrajectory>(std::move(t)));
 }
 
 void MergerPrivate::onNewGeneratorSolution(const SolutionBase& /* s */) {
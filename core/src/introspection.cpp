@@ -46,6 +46,7 @@
 #include <rclcpp/service.hpp>
 #include <moveit/planning_scene/planning_scene.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <boost/bimap.hpp>
 #include <rcutils/isalnum_no_locale.h>
@@ -148,6 +149,8 @@ public:
 		stage_to_id_map_[task_] = 0;  // root is task having ID = 0
 
 		id_solution_bimap_.clear();
+		stage_deltas_.clear();
+		messages_since_snapshot_ = 0;
 	}
 
 	/// associated task
@@ -167,6 +170,37 @@ public:
 	/// mapping from stages to their id
 	std::map<const StagePrivate*, moveit_task_constructor_msgs::msg::StageStatistics::_id_type> stage_to_id_map_;
 	boost::bimap<uint32_t, const SolutionBase*> id_solution_bimap_;
+
+	bool publish_telemetry_ = false;
+	bool binary_only_properties_ = false;
+
+	/// changes of a stage since the previous statistics message
+	struct StageDelta
+	{
+		std::vector<std::pair<double, uint32_t>> solved;  // (cost, id)
+		std::vector<uint32_t> failed;
+		// counters sent with previous message
+		uint32_t num_failed = 0;
+		double total_compute_time = 0.0;
+		// telemetry counters sent with previous message
+		std::size_t num_computes = 0;
+		std::size_t num_waits = 0;
+		std::size_t num_solutions = 0;
+
+		bool telemetryChanged(const StageTelemetry& t) const {
+			return t.computeTimes().count() != num_computes || t.waitTimes().count() != num_waits ||
+			       t.numSolutions() != num_solutions;
+		}
+		void sentTelemetry(const StageTelemetry& t) {
+			num_computes = t.computeTimes().count();
+			num_waits = t.waitTimes().count();
+			num_solutions = t.numSolutions();
+		}
+	};
+	bool incremental_statistics_ = false;
+	unsigned int full_snapshot_period_ = 100;
+	unsigned int messages_since_snapshot_ = 0;
+	std::map<const StagePrivate*, StageDelta> stage_deltas_;
 };
 
 Introspection::Introspection(const TaskPrivate* task) : impl(new IntrospectionPrivate(task, this)) {}
@@ -182,7 +216,31 @@ void Introspection::publishTaskDescription() {
 
 void Introspection::publishTaskState() {
 	::moveit_task_constructor_msgs::msg::TaskStatistics msg;
-	impl->task_statistics_publisher_->publish(fillTaskStatistics(msg));  // NOLINT(clang-analyzer-cplusplus.Move)
+	impl->task_statistics_publisher_->publish(fillTaskState(msg));  // NOLINT(clang-analyzer-cplusplus.Move)
+}
+
+moveit_task_constructor_msgs::msg::TaskStatistics&
+Introspection::fillTaskState(moveit_task_constructor_msgs::msg::TaskStatistics& msg) {
+	if (!impl->incremental_statistics_ || impl->messages_since_snapshot_ == 0) {
+		fillTaskStatistics(msg);
+		if (impl->incremental_statistics_) {  // following deltas only list changes since this full snapshot
+			ContainerBase::StageCallback stage_processor = [this](const Stage& stage, unsigned int /*depth*/) -> bool {
+				auto& delta = impl->stage_deltas_[stage.pimpl()];
+				delta.solved.clear();
+				delta.failed.clear();
+				delta.num_failed = stage.numFailures();
+				delta.total_compute_time = stage.getTotalComputeTime();
+				delta.sentTelemetry(stage.telemetry());
+				return true;
+			};
+			impl->task_->stages()->traverseRecursively(stage_processor);
+		}
+	} else {
+		fillTaskStatisticsDelta(msg);
+	}
+	if (impl->incremental_statistics_ && ++impl->messages_since_snapshot_ >= impl->full_snapshot_period_)
+		impl->messages_since_snapshot_ = 0;
+	return msg;
 }
 
 void Introspection::reset() {
@@ -190,10 +248,47 @@ void Introspection::reset() {
 	impl->resetMaps();
 }
 
+void Introspection::setPublishTelemetry(bool enable) {
+	impl->publish_telemetry_ = enable;
+}
+
+bool Introspection::publishTelemetry() const {
+	return impl->publish_telemetry_;
+}
+
+void Introspection::setBinaryOnlyProperties(bool enable) {
+	impl->binary_only_properties_ = enable;
+}
+
+bool Introspection::binaryOnlyProperties() const {
+	return impl->binary_only_properties_;
+}
+
+void Introspection::setIncrementalStatistics(bool enable, unsigned int full_snapshot_period) {
+	impl->incremental_statistics_ = enable;
+	impl->full_snapshot_period_ = full_snapshot_period;
+	impl->messages_since_snapshot_ = 0;  // start with a full snapshot
+	impl->stage_deltas_.clear();
+}
+
+bool Introspection::incrementalStatistics() const {
+	return impl->incremental_statistics_;
+}
+
 void Introspection::registerSolution(const SolutionBase& s) {
 	solutionId(s);
 }
 
+void Introspection::recordSolution(const SolutionBase& s, bool failed) {
+	if (!impl->incremental_statistics_)
+		return;
+	auto& delta = impl->stage_deltas_[s.creator()->pimpl()];
+	if (failed)
+		delta.failed.push_back(solutionId(s));
+	else
+		delta.solved.emplace_back(s.cost(), solutionId(s));
+}
+
 void Introspection::fillSolution(moveit_task_constructor_msgs::msg::Solution& msg, const SolutionBase& s) {
 	s.toMsg(msg, this);
 	msg.task_id = impl->task_id_;
@@ -255,8 +350,10 @@ uint32_t Introspection::solutionId(const SolutionBase& s) {
 
 void Introspection::fillStageStatistics(const Stage& stage, moveit_task_constructor_msgs::msg::StageStatistics& s) {
 	// successful solutions
-	for (const auto& solution : stage.solutions())
+	for (const auto& solution : stage.solutions()) {
 		s.solved.push_back(solutionId(*solution));
+		s.solved_costs.push_back(solution->cost());
+	}
 
 	// failed solution attempts
 	for (const auto& solution : stage.failures())
@@ -264,6 +361,73 @@ void Introspection::fillStageStatistics(const Stage& stage, moveit_task_construc
 
 	s.total_compute_time = stage.getTotalComputeTime();
 	s.num_failed = stage.numFailures();
+
+	if (impl->publish_telemetry_) {
+		s.telemetry.resize(1);
+		fillStageTelemetry(stage, s.telemetry.front());
+	}
+}
+
+bool Introspection::fillStageStatisticsDelta(const Stage& stage,
+                                             moveit_task_constructor_msgs::msg::StageStatistics& s) {
+	auto& delta = impl->stage_deltas_[stage.pimpl()];
+	const uint32_t num_failed = stage.numFailures();
+	const double total_compute_time = stage.getTotalComputeTime();
+	// telemetry is large (up to max_samples queue depth samples): only resend it if it changed
+	const bool telemetry_changed = impl->publish_telemetry_ && delta.telemetryChanged(stage.telemetry());
+	if (delta.solved.empty() && delta.failed.empty() && delta.num_failed == num_failed &&
+	    delta.total_compute_time == total_compute_time && !telemetry_changed)
+		return false;
+
+	// new successful solutions, sorted by cost as in a full snapshot,
+	// skipping those already moved to the failures again
+	std::sort(delta.solved.begin(), delta.solved.end());
+	for (const auto& solution : delta.solved) {
+		if (std::find(delta.failed.begin(), delta.failed.end(), solution.second) != delta.failed.end())
+			continue;
+		s.solved.push_back(solution.second);
+		s.solved_costs.push_back(solution.first);
+	}
+	s.failed = std::move(delta.failed);
+
+	s.total_compute_time = total_compute_time;
+	s.num_failed = num_failed;
+
+	if (telemetry_changed) {
+		s.telemetry.resize(1);
+		fillStageTelemetry(stage, s.telemetry.front());
+		delta.sentTelemetry(stage.telemetry());
+	}
+
+	delta.solved.clear();
+	delta.failed.clear();
+	delta.num_failed = num_failed;
+	delta.total_compute_time = total_compute_time;
+	return true;
+}
+
+void Introspection::fillStageTelemetry(const Stage& stage, moveit_task_constructor_msgs::msg::StageTelemetry& t) {
+	const StageTelemetry& telemetry = stage.telemetry();
+	t.bucket_bounds.resize(DurationHistogram::NUM_BUCKETS);
+	for (std::size_t i = 0; i < DurationHistogram::NUM_BUCKETS; ++i)
+		t.bucket_bounds[i] = DurationHistogram::upperBound(i);
+	const auto& compute_times = telemetry.computeTimes().buckets();
+	t.compute_time_histogram.assign(compute_times.begin(), compute_times.end());
+	const auto& wait_times = telemetry.waitTimes().buckets();
+	t.wait_time_histogram.assign(wait_times.begin(), wait_times.end());
+	t.mean_wait_time = telemetry.waitTimes().mean();
+	t.max_wait_time = telemetry.waitTimes().max();
+
+	t.queue_depth_time.clear();
+	t.queue_depth.clear();
+	for (const auto& sample : telemetry.queueDepths()) {
+		t.queue_depth_time.push_back(sample.time);
+		t.queue_depth.push_back(sample.depth);
+	}
+	t.max_queue_depth = telemetry.maxQueueDepth();
+
+	t.compute_throughput = telemetry.computeThroughput();
+	t.throughput = telemetry.throughput();
 }
 
 moveit_task_constructor_msgs::msg::TaskDescription&
@@ -281,7 +445,7 @@ Introspection::fillTaskDescription(moveit_task_constructor_msgs::msg::TaskDescri
 			p.name = pair.first;
 			p.description = pair.second.description();
 			p.type = pair.second.typeName();
-			p.value = pair.second.serialize();
+			pair.second.serialize(p.value, p.binary, impl->binary_only_properties_);
 			desc.properties.push_back(p);
 		}
 
@@ -318,6 +482,26 @@ Introspection::fillTaskStatistics(moveit_task_constructor_msgs::msg::TaskStatist
 	impl->task_->stages()->traverseRecursively(stage_processor);
 
 	msg.task_id = impl->task_id_;
+	msg.incremental = false;
+	return msg;
+}
+
+moveit_task_constructor_msgs::msg::TaskStatistics&
+Introspection::fillTaskStatisticsDelta(moveit_task_constructor_msgs::msg::TaskStatistics& msg) {
+	ContainerBase::StageCallback stage_processor = [this, &msg](const Stage& stage, unsigned int /*depth*/) -> bool {
+		moveit_task_constructor_msgs::msg::StageStatistics stat;
+		if (fillStageStatisticsDelta(stage, stat)) {
+			stat.id = stageId(&stage);
+			msg.stages.push_back(std::move(stat));
+		}
+		return true;
+	};
+
+	msg.stages.clear();
+	impl->task_->stages()->traverseRecursively(stage_processor);
+
+	msg.task_id = impl->task_id_;
+	msg.incremental = true;
 	return msg;
 }
 }  // namespace task_constructor
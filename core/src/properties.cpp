@@ -39,6 +39,8 @@
 #include <moveit/task_constructor/properties.h>
 #include <moveit/task_constructor/fmt_p.h>
 #include <functional>
+#include <atomic>
+#include <algorithm>
 #include <boost/core/demangle.hpp>
 #include <rclcpp/logging.hpp>
 #include <rclcpp/clock.hpp>
@@ -48,6 +50,26 @@ namespace task_constructor {
 
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("Properties");
 
+namespace {
+// globally unique, increasing stamps for property versions and map ids
+uint64_t nextStamp() {
+	static std::atomic<uint64_t> counter{ 0 };
+	return ++counter;
+}
+
+// storage shared by all empty PropertyMaps, avoiding allocation until something is declared
+const std::shared_ptr<std::map<std::string, Property>>& emptyStorage() {
+	static const auto storage = std::make_shared<std::map<std::string, Property>>();
+	return storage;
+}
+
+std::shared_ptr<boost::any> makeValue(const boost::any& value) {
+	return value.empty() ? nullptr : std::make_shared<boost::any>(value);
+}
+}  // namespace
+
+const boost::any Property::EMPTY;
+
 class PropertyTypeRegistry
 {
 	struct Entry
@@ -55,6 +77,8 @@ class PropertyTypeRegistry
 		std::string name_;
 		PropertySerializerBase::SerializeFunction serialize_;
 		PropertySerializerBase::DeserializeFunction deserialize_;
+		PropertySerializerBase::BinarySerializeFunction serialize_binary_;
+		PropertySerializerBase::BinaryDeserializeFunction deserialize_binary_;
 	};
 	Entry dummy_;
 
@@ -67,10 +91,12 @@ class PropertyTypeRegistry
 
 public:
 	PropertyTypeRegistry()
-	  : dummy_{ "", PropertySerializerBase::dummySerialize, PropertySerializerBase::dummyDeserialize } {}
-	inline bool insert(const std::type_index& type_index, const std::string& type_name,
-	                   PropertySerializerBase::SerializeFunction serialize,
-	                   PropertySerializerBase::DeserializeFunction deserialize);
+	  : dummy_{ "",
+		          PropertySerializerBase::dummySerialize,
+		          PropertySerializerBase::dummyDeserialize,
+		          PropertySerializerBase::dummySerializeBinary,
+		          PropertySerializerBase::dummyDeserializeBinary } {}
+	inline bool insert(const std::type_index& type_index, const Entry& entry);
 
 	const Entry& entry(const std::type_index& type_index) const {
 		auto it = types_.find(type_index);
@@ -91,32 +117,38 @@ public:
 };
 static PropertyTypeRegistry REGISTRY_SINGLETON;
 
-bool PropertyTypeRegistry::insert(const std::type_index& type_index, const std::string& type_name,
-                                  PropertySerializerBase::SerializeFunction serialize,
-                                  PropertySerializerBase::DeserializeFunction deserialize) {
+bool PropertyTypeRegistry::insert(const std::type_index& type_index, const Entry& entry) {
 	if (type_index == std::type_index(typeid(boost::any)))
 		return false;
 
-	auto it_inserted = types_.insert(std::make_pair(type_index, Entry{ type_name, serialize, deserialize }));
+	auto it_inserted = types_.insert(std::make_pair(type_index, entry));
 	if (!it_inserted.second)
 		return false;  // was already registered before
 
-	if (!type_name.empty())  // register type_name too?
-		names_.insert(std::make_pair(type_name, it_inserted.first));
+	if (!entry.name_.empty())  // register type_name too?
+		names_.insert(std::make_pair(entry.name_, it_inserted.first));
 
 	return true;
 }
 
 bool PropertySerializerBase::insert(const std::type_index& type_index, const std::string& type_name,
                                     PropertySerializerBase::SerializeFunction serialize,
-                                    PropertySerializerBase::DeserializeFunction deserialize) {
-	return REGISTRY_SINGLETON.insert(type_index, type_name, serialize, deserialize);
+                                    PropertySerializerBase::DeserializeFunction deserialize,
+                                    PropertySerializerBase::BinarySerializeFunction serialize_binary,
+                                    PropertySerializerBase::BinaryDeserializeFunction deserialize_binary) {
+	return REGISTRY_SINGLETON.insert(type_index,
+	                                 { type_name, serialize, deserialize, serialize_binary, deserialize_binary });
 }
 
 Property::Property(const type_info& type_info, const std::string& description, const boost::any& default_value)
-  : description_(description), type_info_(type_info), default_(default_value), value_(), initialized_from_(-1) {
+  : description_(description)
+  , type_info_(type_info)
+  , default_(makeValue(default_value))
+  , value_()
+  , initialized_from_(-1)
+  , version_(nextStamp()) {
 	// default value's type should match declared type by construction
-	assert(default_.empty() || default_.type() == type_info_ || type_info_ == typeid(boost::any));
+	assert(!default_ || default_->type() == type_info_ || type_info_ == typeid(boost::any));
 	reset();
 }
 
@@ -129,27 +161,77 @@ void Property::setValue(const boost::any& value) {
 }
 
 void Property::setCurrentValue(const boost::any& value) {
-	if (!value.empty() && type_info_ != typeid(boost::any) && value.type() != type_info_)
-		throw Property::type_error(value.type().name(), type_info_.name());
+	checkType(value);
+	shareCurrentValue(makeValue(value));
+}
 
+void Property::setDefaultValue(const boost::any& value) {
+	checkType(value);
+	default_ = makeValue(value);
+	touch();
+}
+
+void Property::shareValue(const Value& value) {
+	shareCurrentValue(value);
+	default_ = value_;
+	initialized_from_ = 0;
+}
+
+void Property::shareCurrentValue(const Value& value) {
+	if (value)
+		checkType(*value);
 	value_ = value;
 	initialized_from_ = 1;  // manually initialized TODO: use enums
+	touch();
 }
 
-void Property::setDefaultValue(const boost::any& value) {
+void Property::assign(const Property& other) {
+	assert(type_info_ == other.type_info_);
+	description_ = other.description_;
+	default_ = other.default_;
+	value_ = other.value_;
+	source_flags_ = other.source_flags_;
+	initialized_from_ = other.initialized_from_;
+	initializer_ = other.initializer_;
+	init_name_ = other.init_name_;
+	init_stamp_ = other.init_stamp_;
+	version_ = other.version_;
+}
+
+Property::Value Property::sharedValue() const {
+	const Value& value = value_ ? value_ : default_;
+	return value && !value->empty() ? value : nullptr;
+}
+
+void Property::checkType(const boost::any& value) const {
 	if (!value.empty() && type_info_ != typeid(boost::any) && value.type() != type_info_)
 		throw Property::type_error(value.type().name(), type_info_.name());
+}
 
-	default_ = value;
+boost::any& Property::value() {
+	touch();
+	Value& value = value_ ? value_ : default_;
+	if (!value)
+		value = std::make_shared<boost::any>();
+	else if (value.use_count() > 1)  // unshare before modification
+		value = std::make_shared<boost::any>(*value);
+	return *value;
 }
 
 void Property::reset() {
 	if (initialized_from_ == 0)  // TODO: use enum
 		return;  // keep manually set values
-	boost::any().swap(value_);
+	if (value_) {
+		value_.reset();
+		touch();
+	}
 	initialized_from_ = -1;  // set to max value
 }
 
+void Property::touch() {
+	version_ = nextStamp();
+}
+
 std::string Property::serialize(const boost::any& value) {
 	if (value.empty())
 		return "";
@@ -163,6 +245,32 @@ boost::any Property::deserialize(const std::string& type_name, const std::string
 		return REGISTRY_SINGLETON.entry(type_name).deserialize_(wire);
 }
 
+std::vector<uint8_t> Property::serializeBinary(const boost::any& value) {
+	if (value.empty())
+		return {};
+	return REGISTRY_SINGLETON.entry(value.type()).serialize_binary_(value);
+}
+
+boost::any Property::deserializeBinary(const std::string& type_name, const std::vector<uint8_t>& wire) {
+	if (wire.empty())
+		return boost::any();
+	return REGISTRY_SINGLETON.entry(type_name).deserialize_binary_(wire);
+}
+
+void Property::serialize(std::string& text, std::vector<uint8_t>& binary, bool binary_only) const {
+	const boost::any& value = this->value();
+	text.clear();
+	binary.clear();
+	if (value.empty())
+		return;
+
+	const auto& entry = REGISTRY_SINGLETON.entry(value.type());
+	binary = entry.serialize_binary_(value);
+	// if requested, skip the (expensive) text conversion of values having a binary form
+	if (binary.empty() || !binary_only)
+		text = entry.serialize_(value);
+}
+
 std::string Property::typeName() const {
 	if (value().empty())
 		return typeName(type_info_);
@@ -187,16 +295,85 @@ Property& Property::configureInitFrom(SourceFlags source, const Property::Initia
 
 	source_flags_ = f ? source : SourceFlags();
 	initializer_ = f;
+	init_name_.clear();
+	touch();
 	return *this;
 }
 
 Property& Property::configureInitFrom(SourceFlags source, const std::string& name) {
-	return configureInitFrom(source, [name](const PropertyMap& other) { return fromName(other, name); });
+	configureInitFrom(source, [name](const PropertyMap& other) { return fromName(other, name); });
+	init_name_ = name;
+	return *this;
+}
+
+PropertyMap::PropertyMap() : props_(emptyStorage()), id_(nextStamp()) {}
+
+PropertyMap::PropertyMap(const PropertyMap& other)
+  : props_(other.pinned_ ? std::make_shared<Map>(*other.props_) : other.props_), id_(nextStamp()) {}
+
+PropertyMap::PropertyMap(PropertyMap&& other)
+  : props_(std::move(other.props_)), pinned_(other.pinned_), id_(nextStamp()) {
+	other.props_ = emptyStorage();
+	other.pinned_ = false;
+}
+
+PropertyMap& PropertyMap::operator=(const PropertyMap& other) {
+	if (this == &other)
+		return *this;
+	if (pinned_)
+		assignPinned(*other.props_);
+	else
+		props_ = other.pinned_ ? std::make_shared<Map>(*other.props_) : other.props_;
+	id_ = nextStamp();
+	last_init_ = InitStamp();
+	return *this;
+}
+
+PropertyMap& PropertyMap::operator=(PropertyMap&& other) {
+	if (this == &other)
+		return *this;
+	if (pinned_)
+		assignPinned(*other.props_);
+	else {
+		props_ = std::move(other.props_);
+		pinned_ = other.pinned_;
+		other.props_ = emptyStorage();
+		other.pinned_ = false;
+	}
+	id_ = nextStamp();
+	last_init_ = InitStamp();
+	return *this;
+}
+
+PropertyMap::Map& PropertyMap::writable() {
+	if (props_.use_count() > 1)
+		props_ = std::make_shared<Map>(*props_);
+	return *props_;
+}
+
+PropertyMap::Map& PropertyMap::pin() {
+	Map& props = writable();
+	pinned_ = true;
+	return props;
+}
+
+void PropertyMap::assignPinned(const Map& other) {
+	Map& props = *props_;  // pinned storage is never shared
+	for (auto it = props.begin(); it != props.end();) {
+		auto source = other.find(it->first);
+		// an entry can only be updated in place if its declared type remains
+		if (source == other.end() || source->second.type_info_ != it->second.type_info_)
+			it = props.erase(it);
+		else
+			(it++)->second.assign(source->second);
+	}
+	for (const auto& pair : other)
+		props.insert(pair);  // no-op for entries updated above
 }
 
 Property& PropertyMap::declare(const std::string& name, const Property::type_info& type_info,
                                const std::string& description, const boost::any& default_value) {
-	auto it_inserted = props_.insert(std::make_pair(name, Property(type_info, description, default_value)));
+	auto it_inserted = writable().insert(std::make_pair(name, Property(type_info, description, default_value)));
 	// if name was already declared, the new declaration should match in type (except it was boost::any)
 	if (!it_inserted.second && it_inserted.first->second.type_info_ != typeid(boost::any) &&
 	    type_info != it_inserted.first->second.type_info_)
@@ -205,13 +382,21 @@ Property& PropertyMap::declare(const std::string& name, const Property::type_inf
 }
 
 bool PropertyMap::hasProperty(const std::string& name) const {
-	auto it = props_.find(name);
-	return it != props_.end();
+	auto it = props_->find(name);
+	return it != props_->end();
 }
 
 Property& PropertyMap::property(const std::string& name) {
-	auto it = props_.find(name);
-	if (it == props_.end())
+	Map& props = pin();
+	auto it = props.find(name);
+	if (it == props.end())
+		throw Property::undeclared(name);
+	return it->second;
+}
+
+const Property& PropertyMap::property(const std::string& name) const {
+	auto it = props_->find(name);
+	if (it == props_->end())
 		throw Property::undeclared(name);
 	return it->second;
 }
@@ -223,14 +408,14 @@ void PropertyMap::exposeTo(PropertyMap& other, const std::set<std::string>& prop
 
 void PropertyMap::exposeTo(PropertyMap& other, const std::string& name, const std::string& other_name) const {
 	const Property& p = property(name);
-	other.declare(other_name, p.type_info_, p.description_, p.default_);
+	other.declare(other_name, p.type_info_, p.description_, p.defaultValue());
 }
 
 void PropertyMap::configureInitFrom(Property::SourceFlags source, const std::set<std::string>& properties) {
-	for (auto& pair : props_) {
+	for (auto& pair : writable()) {
 		if (properties.empty() || properties.count(pair.first))
 			try {
-				pair.second.configureInitFrom(source, std::bind(&fromName, std::placeholders::_1, pair.first));
+				pair.second.configureInitFrom(source, pair.first);
 			} catch (Property::error& e) {
 				e.setName(pair.first);
 				throw;
@@ -240,18 +425,35 @@ void PropertyMap::configureInitFrom(Property::SourceFlags source, const std::set
 
 template <>
 void PropertyMap::set<boost::any>(const std::string& name, const boost::any& value) {
-	auto range = props_.equal_range(name);
+	Map& props = writable();
+	auto range = props.equal_range(name);
 	if (range.first == range.second) {  // name is not yet declared
 		if (value.empty())
 			throw Property::undeclared(name, "trying to set undeclared property '" + name + "' with NULL value");
-		auto it = props_.insert(range.first, std::make_pair(name, Property(value.type(), "", boost::any())));
+		auto it = props.insert(range.first, std::make_pair(name, Property(value.type(), "", boost::any())));
 		it->second.setValue(value);
 	} else
 		range.first->second.setValue(value);
 }
 
+void PropertyMap::setFrom(const std::string& name, const Property& source) {
+	const Property::Value value = source.sharedValue();
+	Map& props = writable();
+	auto range = props.equal_range(name);
+	if (range.first == range.second) {  // name is not yet declared
+		if (!value)
+			throw Property::undeclared(name, "trying to set undeclared property '" + name + "' with NULL value");
+		range.first = props.insert(range.first, std::make_pair(name, Property(value->type(), "", boost::any())));
+	}
+	range.first->second.shareValue(value);
+}
+
 void PropertyMap::setCurrent(const std::string& name, const boost::any& value) {
-	property(name).setCurrentValue(value);
+	Map& props = writable();
+	auto it = props.find(name);
+	if (it == props.end())
+		throw Property::undeclared(name);
+	it->second.setCurrentValue(value);
 }
 
 const boost::any& PropertyMap::get(const std::string& name) const {
@@ -268,12 +470,26 @@ size_t PropertyMap::countDefined(const std::vector<std::string>& list) const {
 }
 
 void PropertyMap::reset() {
-	for (auto& pair : props_)
+	for (auto& pair : writable())
 		pair.second.reset();
 }
 
+uint64_t PropertyMap::version() const {
+	// every modification assigns a new, globally maximal stamp to the modified property
+	uint64_t result = 0;
+	for (const auto& pair : *props_)
+		result = std::max(result, pair.second.version_);
+	return result;
+}
+
 void PropertyMap::performInitFrom(Property::SourceFlags source, const PropertyMap& other) {
-	for (auto& pair : props_) {
+	// nothing to do if neither map changed since last initialization from the same source
+	const uint64_t other_version = other.version();
+	if (last_init_.source == source && last_init_.other_id == other.id_ &&
+	    last_init_.other_version == other_version && last_init_.version == version())
+		return;
+
+	for (auto& pair : writable()) {
 		Property& p = pair.second;
 
 		// don't override value previously set by higher-priority source
@@ -284,6 +500,23 @@ void PropertyMap::performInitFrom(Property::SourceFlags source, const PropertyMa
 		if (!p.initsFrom(source))
 			continue;
 
+		if (!p.init_name_.empty()) {  // initialization by name: directly share value of source property
+			auto it = other.props_->find(p.init_name_);
+			if (it == other.props_->end())
+				continue;  // ignore undeclared
+			const Property& other_p = it->second;
+			// skip if neither source property nor p changed since last initialization
+			if (p.init_stamp_ == Property::InitStamp{ other.id_, other_p.version_, p.version_ })
+				continue;
+
+			RCLCPP_DEBUG_STREAM(LOGGER, fmt::format("{}: {} -> {}: {}", pair.first, p.initialized_from_, source,
+			                                        Property::serialize(other_p.value())));
+			p.shareCurrentValue(other_p.sharedValue());
+			p.initialized_from_ = source;
+			p.init_stamp_ = Property::InitStamp{ other.id_, other_p.version_, p.version_ };
+			continue;
+		}
+
 		boost::any value;
 		try {
 			value = p.initializer_(other);
@@ -298,6 +531,7 @@ void PropertyMap::performInitFrom(Property::SourceFlags source, const PropertyMa
 		p.setCurrentValue(value);
 		p.initialized_from_ = source;
 	}
+	last_init_ = InitStamp{ source, other.id_, other_version, version() };
 }
 
 boost::any fromName(const PropertyMap& other, const std::string& other_name) {
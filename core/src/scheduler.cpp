@@ -0,0 +1,71 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/task_constructor/scheduler.h>
+#include <moveit/task_constructor/stage_p.h>
+
+#include <algorithm>
+
+namespace moveit {
+namespace task_constructor {
+
+SchedulingCandidate::SchedulingCandidate(const Stage& stage)
+  : stage(&stage)
+  , priority(stage.pimpl()->pendingPriority())
+  , num_solutions(stage.solutions().size())
+  , num_failures(stage.numFailures())
+  , num_computes(stage.pimpl()->numComputes())
+  , compute_time(stage.getTotalComputeTime()) {}
+
+void BestFirstScheduler::schedule(Candidates& candidates) const {
+	// keep original order of equally ranked candidates
+	std::stable_sort(candidates.begin(), candidates.end(),
+	                 [this](const SchedulingCandidate& a, const SchedulingCandidate& b) { return better(a, b); });
+	if (candidates.size() > max_stages_)
+		candidates.erase(candidates.begin() + max_stages_, candidates.end());
+}
+
+bool DeepestFirstScheduler::better(const SchedulingCandidate& a, const SchedulingCandidate& b) const {
+	return a.priority < b.priority;
+}
+
+bool CheapestExpectedCostScheduler::better(const SchedulingCandidate& a, const SchedulingCandidate& b) const {
+	double cost_a = a.expectedCost();
+	double cost_b = b.expectedCost();
+	if (cost_a != cost_b)
+		return cost_a < cost_b;
+	return a.priority < b.priority;
+}
+}  // namespace task_constructor
+}  // namespace moveit
@@ -67,6 +67,12 @@ CartesianPath::CartesianPath() {
 
 void CartesianPath::init(const core::RobotModelConstPtr& /*robot_model*/) {}
 
+PlannerInterfacePtr CartesianPath::clone() const {
+	auto planner = std::make_shared<CartesianPath>();
+	planner->properties() = properties();
+	return planner;
+}
+
 void CartesianPath::setIKFrame(const Eigen::Isometry3d& pose, const std::string& link) {
 	geometry_msgs::msg::PoseStamped pose_msg;
 	pose_msg.header.frame_id = link;
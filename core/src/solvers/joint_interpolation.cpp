@@ -59,6 +59,12 @@ JointInterpolationPlanner::JointInterpolationPlanner() {
 
 void JointInterpolationPlanner::init(const core::RobotModelConstPtr& /*robot_model*/) {}
 
+PlannerInterfacePtr JointInterpolationPlanner::clone() const {
+	auto planner = std::make_shared<JointInterpolationPlanner>();
+	planner->properties() = properties();
+	return planner;
+}
+
 PlannerInterface::Result JointInterpolationPlanner::plan(const planning_scene::PlanningSceneConstPtr& from,
                                                          const planning_scene::PlanningSceneConstPtr& to,
                                                          const moveit::core::JointModelGroup* jmg, double /*timeout*/,
@@ -49,6 +49,18 @@ void MultiPlanner::init(const core::RobotModelConstPtr& robot_model) {
 		p->init(robot_model);
 }
 
+PlannerInterfacePtr MultiPlanner::clone() const {
+	auto planner = std::make_shared<MultiPlanner>();
+	planner->properties() = properties();
+	for (const auto& p : *this) {
+		PlannerInterfacePtr cloned = p->clone();
+		if (!cloned)
+			return nullptr;  // all planners need to be cloned
+		planner->push_back(cloned);
+	}
+	return planner;
+}
+
 PlannerInterface::Result MultiPlanner::plan(const planning_scene::PlanningSceneConstPtr& from,
                                             const planning_scene::PlanningSceneConstPtr& to,
                                             const moveit::core::JointModelGroup* jmg, double timeout,
@@ -56,6 +56,7 @@ PipelinePlanner::PipelinePlanner(
     const moveit::planning_pipeline_interfaces::StoppingCriterionFunction& stopping_criterion_callback,
     const moveit::planning_pipeline_interfaces::SolutionSelectionFunction& solution_selection_function)
   : node_(node)
+  , shared_pipelines_(std::make_shared<SharedPipelines>())
   , stopping_criterion_callback_(stopping_criterion_callback)
   , solution_selection_function_(solution_selection_function) {
 	// Declare properties of the MotionPlanRequest
@@ -96,36 +97,68 @@ void PipelinePlanner::setSolutionSelectionFunction(
 }
 
 void PipelinePlanner::init(const core::RobotModelConstPtr& robot_model) {
-	// Create planning pipelines once from pipeline_id_planner_id_map.
+	auto& p = properties();
+	pipeline_id_planner_id_map_ = p.handle<PipelineMap>("pipeline_id_planner_id_map");
+	num_planning_attempts_ = p.handle<uint>("num_planning_attempts");
+	max_velocity_scaling_factor_ = p.handle<double>("max_velocity_scaling_factor");
+	max_acceleration_scaling_factor_ = p.handle<double>("max_acceleration_scaling_factor");
+	workspace_parameters_ = p.handle<moveit_msgs::msg::WorkspaceParameters>("workspace_parameters");
+	goal_joint_tolerance_ = p.handle<double>("goal_joint_tolerance");
+	goal_position_tolerance_ = p.handle<double>("goal_position_tolerance");
+	goal_orientation_tolerance_ = p.handle<double>("goal_orientation_tolerance");
+
+	const auto& map = pipeline_id_planner_id_map_.get();
+	if (map.empty()) {
+		throw std::runtime_error("Cannot initialize PipelinePlanner: pipeline_id_planner_id_map is empty!");
+	}
+
+	// Create planning pipelines once from pipeline_id_planner_id_map, shared with all clones.
 	// We assume that all parameters required by the pipeline can be found
 	// in the namespace of the pipeline name.
-	if (planning_pipelines_.empty()) {
-		auto map = properties().get<PipelineMap>("pipeline_id_planner_id_map");
-		// Create pipeline name vector from the keys of pipeline_id_planner_id_map_
-		if (map.empty()) {
-			throw std::runtime_error("Cannot initialize PipelinePlanner: pipeline_id_planner_id_map is empty!");
+	std::lock_guard<std::mutex> lock(shared_pipelines_->mutex);
+	auto& planning_pipelines = shared_pipelines_->pipelines;
+	// Validate that existing pipelines use the task's robot model
+	for (const auto& pair : planning_pipelines) {
+		if (pair.second->getRobotModel() != robot_model) {
+			throw std::runtime_error(
+			    "The robot model of the planning pipeline isn't the same as the task's robot model -- ");
 		}
+	}
 
-		std::vector<std::string> pipeline_names;
-		pipeline_names.reserve(map.size());
-		for (const auto& pipeline_name_planner_id_pair : map) {
+	// Create pipelines not tried yet, i.e. all on first init() or additional ones configured for a clone
+	std::vector<std::string> pipeline_names;
+	for (const auto& pipeline_name_planner_id_pair : map) {
+		if (shared_pipelines_->requested.insert(pipeline_name_planner_id_pair.first).second)
 			pipeline_names.push_back(pipeline_name_planner_id_pair.first);
-		}
-		planning_pipelines_ =
+	}
+	if (!pipeline_names.empty()) {
+		auto created =
 		    moveit::planning_pipeline_interfaces::createPlanningPipelineMap(pipeline_names, robot_model, node_);
-		// Check if it is still empty
-		if (planning_pipelines_.empty()) {
-			throw std::runtime_error("Failed to initialize PipelinePlanner: Could not create any valid pipeline");
-		}
-	} else {
-		// Validate that all pipelines use the task's robot model
-		for (const auto& pair : planning_pipelines_) {
-			if (pair.second->getRobotModel() != robot_model) {
-				throw std::runtime_error(
-				    "The robot model of the planning pipeline isn't the same as the task's robot model -- ");
-			}
-		}
+		planning_pipelines.insert(created.begin(), created.end());
 	}
+	// Check if it is still empty
+	if (planning_pipelines.empty()) {
+		throw std::runtime_error("Failed to initialize PipelinePlanner: Could not create any valid pipeline");
+	}
+	planning_pipelines_ = planning_pipelines;
+}
+
+std::string PipelinePlanner::getPlannerId() const {
+	std::lock_guard<std::mutex> lock(last_successful_planner_mutex_);
+	return last_successful_planner_;
+}
+
+void PipelinePlanner::setLastSuccessfulPlanner(const std::string& planner_id) {
+	std::lock_guard<std::mutex> lock(last_successful_planner_mutex_);
+	last_successful_planner_ = planner_id;
+}
+
+PlannerInterfacePtr PipelinePlanner::clone() const {
+	auto planner = std::make_shared<PipelinePlanner>(node_, properties().get<PipelineMap>("pipeline_id_planner_id_map"),
+	                                                 stopping_criterion_callback_, solution_selection_function_);
+	planner->properties() = properties();
+	planner->shared_pipelines_ = shared_pipelines_;  // pipelines are created (once) in init()
+	return planner;
 }
 
 PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSceneConstPtr& from,
@@ -135,7 +168,7 @@ PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSce
                                                const moveit_msgs::msg::Constraints& path_constraints) {
 	// Construct goal constraints from the goal planning scene
 	const auto goal_constraints = kinematic_constraints::constructGoalConstraints(
-	    to->getCurrentState(), joint_model_group, properties().get<double>("goal_joint_tolerance"));
+	    to->getCurrentState(), joint_model_group, goal_joint_tolerance_.get());
 	return plan(from, joint_model_group, goal_constraints, timeout, result, path_constraints);
 }
 
@@ -151,8 +184,7 @@ PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSce
 	target.pose = tf2::toMsg(target_eigen * offset.inverse());
 
 	const auto goal_constraints = kinematic_constraints::constructGoalConstraints(
-	    link.getName(), target, properties().get<double>("goal_position_tolerance"),
-	    properties().get<double>("goal_orientation_tolerance"));
+	    link.getName(), target, goal_position_tolerance_.get(), goal_orientation_tolerance_.get());
 
 	return plan(from, joint_model_group, goal_constraints, timeout, result, path_constraints);
 }
@@ -162,8 +194,8 @@ PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSce
                                                const moveit_msgs::msg::Constraints& goal_constraints, double timeout,
                                                robot_trajectory::RobotTrajectoryPtr& result,
                                                const moveit_msgs::msg::Constraints& path_constraints) {
-	const auto& map = properties().get<PipelineMap>("pipeline_id_planner_id_map");
-	last_successful_planner_ = "Unknown";
+	const auto& map = pipeline_id_planner_id_map_.get();
+	setLastSuccessfulPlanner("Unknown");
 
 	// Create a request for every planning pipeline that should run in parallel
 	std::vector<moveit_msgs::msg::MotionPlanRequest> requests;
@@ -182,10 +214,10 @@ PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSce
 		request.planner_id = planner_id;
 		request.allowed_planning_time = timeout;
 		request.start_state.is_diff = true;  // we don't specify an extra start state
-		request.num_planning_attempts = properties().get<uint>("num_planning_attempts");
-		request.max_velocity_scaling_factor = properties().get<double>("max_velocity_scaling_factor");
-		request.max_acceleration_scaling_factor = properties().get<double>("max_acceleration_scaling_factor");
-		request.workspace_parameters = properties().get<moveit_msgs::msg::WorkspaceParameters>("workspace_parameters");
+		request.num_planning_attempts = num_planning_attempts_.get();
+		request.max_velocity_scaling_factor = max_velocity_scaling_factor_.get();
+		request.max_acceleration_scaling_factor = max_acceleration_scaling_factor_.get();
+		request.workspace_parameters = workspace_parameters_.get();
 		request.goal_constraints.resize(1);
 		request.goal_constraints.at(0) = goal_constraints;
 		request.path_constraints = path_constraints;
@@ -204,7 +236,7 @@ PlannerInterface::Result PipelinePlanner::plan(const planning_scene::PlanningSce
 		if (solution) {
 			// Choose the first solution trajectory as response
 			result = solution.trajectory;
-			last_successful_planner_ = solution.planner_id;
+			setLastSuccessfulPlanner(solution.planner_id);
 			return { true, "" };
 		}
 		return { false, solution.error_code.message };
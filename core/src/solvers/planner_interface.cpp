@@ -37,6 +37,7 @@
 */
 
 #include <moveit/task_constructor/solvers/planner_interface.h>
+#include <moveit/task_constructor/thread_pool.h>
 #include <moveit/trajectory_processing/time_optimal_trajectory_generation.hpp>
 
 using namespace trajectory_processing;
@@ -52,6 +53,66 @@ PlannerInterface::PlannerInterface() {
 	p.declare<double>("max_acceleration_scaling_factor", 1.0, "scale down max acceleration by this factor");
 	p.declare<TimeParameterizationPtr>("time_parameterization", std::make_shared<TimeOptimalTrajectoryGeneration>());
 }
+
+PlannerInterface::Future PlannerInterface::runAsync(ThreadPool* pool, PlanFunction&& plan) {
+	auto cancelled = std::make_shared<std::atomic<bool>>(false);
+	PlannerInterfacePtr self = weak_from_this().lock();
+	if (!self || !pool) {  // cannot guarantee our lifetime or no pool available: plan synchronously
+		std::promise<AsyncResult> promise;
+		AsyncResult result;
+		result.result = plan(*this, result.trajectory);
+		promise.set_value(std::move(result));
+		return Future(promise.get_future().share(), cancelled);
+	}
+
+	// The job runs exactly once: either on the pool or in the first thread waiting for its result.
+	// It keeps the planner alive until it finished.
+	auto promise = std::make_shared<std::promise<AsyncResult>>();
+	auto started = std::make_shared<std::atomic<bool>>(false);
+	auto run = std::make_shared<std::function<void()>>(
+	    [self = std::move(self), plan = std::move(plan), cancelled, promise, started]() {
+		    if (started->exchange(true))
+			    return;
+		    AsyncResult result;
+		    if (*cancelled)
+			    result.result = { false, "cancelled" };
+		    else {
+			    try {
+				    std::lock_guard<std::mutex> lock(self->plan_mutex_);
+				    result.result = plan(*self, result.trajectory);
+			    } catch (...) {
+				    promise->set_exception(std::current_exception());
+				    return;
+			    }
+		    }
+		    promise->set_value(std::move(result));
+	    });
+	pool->submit([run]() { (*run)(); });
+	return Future(promise->get_future().share(), cancelled, run);
+}
+
+PlannerInterface::Future PlannerInterface::planAsync(ThreadPool* pool,
+                                                     const planning_scene::PlanningSceneConstPtr& from,
+                                                     const planning_scene::PlanningSceneConstPtr& to,
+                                                     const moveit::core::JointModelGroup* jmg, double timeout,
+                                                     const moveit_msgs::msg::Constraints& path_constraints) {
+	return runAsync(pool, [from, to, jmg, timeout, path_constraints](PlannerInterface& planner,
+	                                                                 robot_trajectory::RobotTrajectoryPtr& result) {
+		return planner.plan(from, to, jmg, timeout, result, path_constraints);
+	});
+}
+
+PlannerInterface::Future PlannerInterface::planAsync(ThreadPool* pool,
+                                                     const planning_scene::PlanningSceneConstPtr& from,
+                                                     const moveit::core::LinkModel& link,
+                                                     const Eigen::Isometry3d& offset, const Eigen::Isometry3d& target,
+                                                     const moveit::core::JointModelGroup* jmg, double timeout,
+                                                     const moveit_msgs::msg::Constraints& path_constraints) {
+	return runAsync(pool, [from, link = &link, offset, target, jmg, timeout, path_constraints](
+	                    PlannerInterface& planner, robot_trajectory::RobotTrajectoryPtr& result) {
+		return planner.plan(from, *link, offset, target, jmg, timeout, result, path_constraints);
+	});
+}
 }  // namespace solvers
 }  // namespace task_constructor
 }  // namespace moveit
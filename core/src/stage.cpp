@@ -97,6 +97,8 @@ std::ostream& operator<<(std::ostream& os, const InitStageException& e) {
 	return os;
 }
 
+thread_local CommitBuffer* CommitBuffer::active_ = nullptr;
+
 StagePrivate::StagePrivate(Stage* me, const std::string& name)
   : me_{ me }
   , name_{ name }
@@ -104,6 +106,7 @@ StagePrivate::StagePrivate(Stage* me, const std::string& name)
   , total_compute_time_{}
   , parent_{ nullptr }
   , introspection_{ nullptr }
+  , thread_pool_{ nullptr }
   , preempt_requested_{ nullptr } {}
 
 StagePrivate& StagePrivate::operator=(StagePrivate&& other) {
@@ -146,6 +149,33 @@ InterfaceFlags StagePrivate::interfaceFlags() const {
 	return f;
 }
 
+InterfaceState::Priority StagePrivate::pendingPriority() const {
+	// pull interfaces are sorted: the front state is the most promising one
+	InterfaceState::Priority best = noPendingPriority();
+	for (const InterfaceConstPtr& interface : { starts(), ends() }) {
+		if (!interface || interface->empty())
+			continue;
+		const InterfaceState::Priority& prio = interface->front()->priority();
+		if (prio < best)
+			best = prio;
+	}
+	return best;
+}
+
+std::size_t StagePrivate::queueDepth() const {
+	std::size_t depth = 0;
+	for (const InterfaceConstPtr& interface : { starts(), ends() })
+		if (interface)
+			depth += interface->size();
+	return depth;
+}
+
+void StagePrivate::setArena(const ArenaPtr& arena) {
+	arena_ = arena;
+	if (states_.empty())
+		states_ = StateList(ArenaAllocator<InterfaceState>(arena_));
+}
+
 void StagePrivate::validateConnectivity() const {
 	// check that the required interface is provided
 	InterfaceFlags required = requiredInterface();
@@ -173,11 +203,40 @@ bool StagePrivate::storeSolution(const SolutionBasePtr& solution, const Interfac
 	} else {
 		solutions_.insert(solution);
 	}
+	if (introspection_)
+		introspection_->recordSolution(*solution, solution->isFailure());
 	return true;
 }
 
+std::vector<SolutionBaseConstPtr>
+StagePrivate::discardSolutions(const std::function<bool(const SolutionBase&)>& predicate, const std::string& comment) {
+	std::vector<SolutionBaseConstPtr> discarded;
+	for (auto it = solutions_.begin(); it != solutions_.end();) {
+		if (!predicate(**it)) {
+			++it;
+			continue;
+		}
+		discarded.push_back(*it);
+		it = solutions_.erase(it);  // erase before marking as failure: the cost defines the order of solutions_
+
+		const_cast<SolutionBase&>(*discarded.back()).markAsFailure(comment);
+		++num_failures_;
+		if (storeFailures())
+			failures_.push_back(discarded.back());
+		// always report the discard, as clients would keep the solution as successful otherwise
+		if (introspection_)
+			introspection_->recordSolution(*discarded.back(), true);
+	}
+	return discarded;
+}
+
 void StagePrivate::sendForward(const InterfaceState& from, InterfaceState&& to, const SolutionBasePtr& solution) {
 	assert(nextStarts());
+	if (CommitBuffer* buffer = CommitBuffer::active()) {
+		buffer->defer(
+		    [this, &from, to = std::move(to), solution]() mutable { sendForward(from, std::move(to), solution); });
+		return;
+	}
 
 	computeCost(from, to, *solution);
 
@@ -200,6 +259,11 @@ void StagePrivate::sendForward(const InterfaceState& from, InterfaceState&& to,
 
 void StagePrivate::sendBackward(InterfaceState&& from, const InterfaceState& to, const SolutionBasePtr& solution) {
 	assert(prevEnds());
+	if (CommitBuffer* buffer = CommitBuffer::active()) {
+		buffer->defer(
+		    [this, from = std::move(from), &to, solution]() mutable { sendBackward(std::move(from), to, solution); });
+		return;
+	}
 
 	computeCost(from, to, *solution);
 
@@ -221,6 +285,12 @@ void StagePrivate::sendBackward(InterfaceState&& from, const InterfaceState& to,
 
 void StagePrivate::spawn(InterfaceState&& from, InterfaceState&& to, const SolutionBasePtr& solution) {
 	assert(prevEnds() && nextStarts());
+	if (CommitBuffer* buffer = CommitBuffer::active()) {
+		buffer->defer([this, from = std::move(from), to = std::move(to), solution]() mutable {
+			spawn(std::move(from), std::move(to), solution);
+		});
+		return;
+	}
 
 	computeCost(from, to, *solution);
 
@@ -246,6 +316,10 @@ void StagePrivate::spawn(InterfaceState&& state, const SolutionBasePtr& solution
 }
 
 void StagePrivate::connect(const InterfaceState& from, const InterfaceState& to, const SolutionBasePtr& solution) {
+	if (CommitBuffer* buffer = CommitBuffer::active()) {
+		buffer->defer([this, &from, &to, solution]() { connect(from, to, solution); });
+		return;
+	}
 	computeCost(from, to, *solution);
 
 	if (!storeSolution(solution, &from, &to))
@@ -262,6 +336,8 @@ void StagePrivate::newSolution(const SolutionBasePtr& solution) {
 	for (const auto& cb : solution_cbs_)
 		cb(*solution);
 
+	if (!solution->isFailure())
+		telemetry_.recordSolution();
 	if (parent() && !solution->isFailure())
 		parent()->onNewSolution(*solution);
 }
@@ -337,7 +413,8 @@ void Stage::reset() {
 	impl->solutions_.clear();
 	impl->failures_.clear();
 	impl->num_failures_ = 0u;
-	impl->states_.clear();
+	// release states, further states are allocated from the (possibly renewed) arena
+	impl->states_ = StagePrivate::StateList(ArenaAllocator<InterfaceState>(impl->arena_));
 	// clear pull interfaces
 	if (impl->starts_)
 		impl->starts_->clear();
@@ -349,6 +426,8 @@ void Stage::reset() {
 	// reset inherited properties
 	impl->properties_.reset();
 	impl->total_compute_time_ = std::chrono::duration<double>::zero();
+	impl->num_computes_ = 0u;
+	impl->telemetry_.reset();
 }
 
 void Stage::init(const moveit::core::RobotModelConstPtr& /* robot_model */) {
@@ -397,7 +476,7 @@ void Stage::forwardProperties(const InterfaceState& source, InterfaceState& dest
 	for (const auto& name : forwardedProperties()) {
 		if (!src.hasProperty(name))
 			continue;
-		dst.set(name, src.get(name));
+		dst.setFrom(name, src.property(name));  // share value instead of copying it
 	}
 }
 
@@ -449,6 +528,14 @@ double Stage::getTotalComputeTime() const {
 	return pimpl()->total_compute_time_.count();
 }
 
+const StageTelemetry& Stage::telemetry() const {
+	return pimpl()->telemetry_;
+}
+
+const ArenaPtr& Stage::arena() const {
+	return pimpl()->arena();
+}
+
 void StagePrivate::composePropertyErrorMsg(const std::string& property_name, std::ostream& os) {
 	if (property_name.empty())
 		return;
@@ -505,8 +592,89 @@ std::ostream& operator<<(std::ostream& os, const StagePrivate& impl) {
 	return os;
 }
 
+std::size_t ComputeBasePrivate::finishReadyRequests() {
+	std::size_t finished = 0;
+	// finish() might append new requests: only consider the current ones
+	for (std::size_t i = 0, num = pending_requests_.size(); i < num; ++i) {
+		AsyncRequest request = std::move(pending_requests_.front());
+		pending_requests_.pop_front();
+		if (request.ready()) {
+			request.finish();
+			++finished;
+		} else
+			pending_requests_.push_back(std::move(request));  // keep order of remaining requests
+	}
+	return finished;
+}
+
+void ComputeBasePrivate::finishOldestRequest() {
+	AsyncRequest request = std::move(pending_requests_.front());
+	pending_requests_.pop_front();
+	if (!request.ready()) {
+		if (preempted()) {
+			pending_requests_.push_front(std::move(request));
+			throw PreemptStageException();
+		}
+		request.wait();
+	}
+	request.finish();
+}
+
+void ComputeBasePrivate::cancelRequests() {
+	for (AsyncRequest& request : pending_requests_) {
+		if (request.cancel)
+			request.cancel();
+	}
+	pending_requests_.clear();
+}
+
 ComputeBase::ComputeBase(ComputeBasePrivate* impl) : Stage(impl) {}
 
+void ComputeBase::reset() {
+	pimpl()->cancelRequests();
+	Stage::reset();
+}
+
+void ComputeBase::setMaxPendingRequests(std::size_t max) {
+	pimpl()->max_pending_requests_ = max;
+}
+
+std::size_t ComputeBase::maxPendingRequests() const {
+	return pimpl()->max_pending_requests_;
+}
+
+std::size_t ComputeBase::numPendingRequests() const {
+	return pimpl()->pending_requests_.size();
+}
+
+void ComputeBase::setInterfaceStorage(Interface::Storage storage, std::size_t capacity) {
+	auto impl = pimpl();
+	for (const InterfacePtr& interface : { impl->starts(), impl->ends() })
+		if (interface)
+			interface->setStorage(storage, capacity);
+	impl->interface_storage_ = storage;
+	impl->interface_capacity_ = capacity;
+}
+
+Interface::Storage ComputeBase::interfaceStorage() const {
+	return pimpl()->interface_storage_;
+}
+
+InterfacePtr ComputeBasePrivate::createPullInterface(Interface::Direction dir) {
+	auto interface = std::make_shared<Interface>(Interface::NotifyFunction(), interface_storage_, interface_capacity_);
+	// a dropped state will never be computed: prune its solution branch
+	interface->setDropFunction([this, dir](InterfaceState* state) {
+		if (parent())
+			parent()->pimpl()->onDroppedState(dir, state);
+	});
+	return interface;
+}
+
+void ComputeBase::finishAsync(std::function<bool()> ready, std::function<void()> wait, std::function<void()> finish,
+                              std::function<void()> cancel) {
+	pimpl()->pending_requests_.push_back({ std::move(ready), std::move(wait), std::move(finish), std::move(cancel) });
+}
+
 PropagatingEitherWayPrivate::PropagatingEitherWayPrivate(PropagatingEitherWay* me, PropagatingEitherWay::Direction dir,
                                                          const std::string& name)
   : ComputeBasePrivate(me, name), configured_dir_(dir) {
@@ -519,14 +687,14 @@ void PropagatingEitherWayPrivate::initInterface(PropagatingEitherWay::Direction
 		case PropagatingEitherWay::FORWARD:
 			required_interface_ = PROPAGATE_FORWARDS;
 			if (!starts_)  // keep existing interface if possible
-				starts_ = std::make_shared<Interface>();
+				starts_ = createPullInterface(Interface::FORWARD);
 			ends_.reset();
 			return;
 		case PropagatingEitherWay::BACKWARD:
 			required_interface_ = PROPAGATE_BACKWARDS;
 			starts_.reset();
 			if (!ends_)  // keep existing interface if possible
-				ends_ = std::make_shared<Interface>();
+				ends_ = createPullInterface(Interface::BACKWARD);
 			return;
 		case PropagatingEitherWay::AUTO:
 			required_interface_ = UNKNOWN;
@@ -566,7 +734,9 @@ inline bool PropagatingEitherWayPrivate::hasStartState() const {
 
 const InterfaceState& PropagatingEitherWayPrivate::fetchStartState() {
 	assert(hasStartState());
-	return *starts_->remove(starts_->begin()).front();
+	const InterfaceState& state = *starts_->remove(starts_->begin()).front();
+	telemetry_.recordWait(state.enqueueTime(), std::chrono::steady_clock::now());
+	return state;
 }
 
 inline bool PropagatingEitherWayPrivate::hasEndState() const {
@@ -575,23 +745,32 @@ inline bool PropagatingEitherWayPrivate::hasEndState() const {
 
 const InterfaceState& PropagatingEitherWayPrivate::fetchEndState() {
 	assert(hasEndState());
-	return *ends_->remove(ends_->begin()).front();
+	const InterfaceState& state = *ends_->remove(ends_->begin()).front();
+	telemetry_.recordWait(state.enqueueTime(), std::chrono::steady_clock::now());
+	return state;
 }
 
 bool PropagatingEitherWayPrivate::canCompute() const {
-	return hasStartState() || hasEndState();
+	return (acceptsRequests() && (hasStartState() || hasEndState())) || hasPendingRequests();
 }
 
 void PropagatingEitherWayPrivate::compute() {
 	PropagatingEitherWay* me = static_cast<PropagatingEitherWay*>(me_);
 
+	bool finished = finishReadyRequests() > 0;
+	if (!acceptsRequests() || !(hasStartState() || hasEndState())) {
+		if (!finished && hasPendingRequests())  // nothing else to do: wait for a pending request
+			finishOldestRequest();
+		return;
+	}
+
 	if (hasStartState()) {
 		const InterfaceState& state = fetchStartState();
 		// enforce property initialization from INTERFACE
 		properties_.performInitFrom(Stage::INTERFACE, state.properties());
 		me->computeForward(state);
 	}
-	if (hasEndState()) {
+	if (hasEndState() && acceptsRequests()) {
 		const InterfaceState& state = fetchEndState();
 		// enforce property initialization from INTERFACE
 		properties_.performInitFrom(Stage::INTERFACE, state.properties());
@@ -616,7 +795,7 @@ void PropagatingEitherWay::restrictDirection(PropagatingEitherWay::Direction dir
 
 template <Interface::Direction dir>
 void PropagatingEitherWay::send(const InterfaceState& start, InterfaceState&& end, SubTrajectory&& trajectory) {
-	pimpl()->send<dir>(start, std::move(end), std::make_shared<SubTrajectory>(std::move(trajectory)));
+	pimpl()->send<dir>(start, std::move(end), makeShared<SubTrajectory>(std::move(trajectory)));
 }
 // Explicit template instantiation is required. The compiler, otherwise, might just inline them.
 template void PropagatingEitherWay::send<Interface::FORWARD>(const InterfaceState& start, InterfaceState&& end,
@@ -686,12 +865,20 @@ void GeneratorPrivate::compute() {
 Generator::Generator(GeneratorPrivate* impl) : ComputeBase(impl) {}
 Generator::Generator(const std::string& name) : Generator(new GeneratorPrivate(this, name)) {}
 
+void Generator::setCostLowerBound(double bound) {
+	pimpl()->cost_lower_bound_ = bound;
+}
+
+double Generator::costLowerBound() const {
+	return pimpl()->cost_lower_bound_;
+}
+
 void Generator::spawn(InterfaceState&& from, InterfaceState&& to, SubTrajectory&& t) {
-	pimpl()->spawn(std::move(from), std::move(to), std::make_shared<SubTrajectory>(std::move(t)));
+	pimpl()->spawn(std::move(from), std::move(to), makeShared<SubTrajectory>(std::move(t)));
 }
 
 void Generator::spawn(InterfaceState&& state, SubTrajectory&& t) {
-	pimpl()->spawn(std::move(state), std::make_shared<SubTrajectory>(std::move(t)));
+	pimpl()->spawn(std::move(state), makeShared<SubTrajectory>(std::move(t)));
 }
 
 MonitoringGeneratorPrivate::MonitoringGeneratorPrivate(MonitoringGenerator* me, const std::string& name)
@@ -756,24 +943,176 @@ ConnectingPrivate::StatePair ConnectingPrivate::make_pair<Interface::FORWARD>(In
 	return StatePair(second, first);
 }
 
+bool ConnectingPrivate::PendingPairs::Later::operator()(const Entry& a, const Entry& b) const {
+	if (StatePair::less(b.first, b.second, a.first, a.second))
+		return true;
+	if (StatePair::less(a.first, a.second, b.first, b.second))
+		return false;
+	return a.seq > b.seq;  // FIFO order for equal priorities
+}
+
+void ConnectingPrivate::PendingPairs::insert(const StatePair& pair) {
+	std::size_t node;
+	if (free_.empty()) {
+		node = nodes_.size();
+		nodes_.push_back(Node{ pair, 0, 0, true });
+	} else {  // reuse node of a popped pair, keeping its version to outdate its remaining queue entries
+		node = free_.back();
+		free_.pop_back();
+		nodes_[node].pair = pair;
+		nodes_[node].alive = true;
+	}
+	adjacency_[&*pair.first].push_back(node);
+	adjacency_[&*pair.second].push_back(node);
+	++size_;
+	enqueue(node);
+}
+
+void ConnectingPrivate::PendingPairs::update(const InterfaceState* state) {
+	auto it = adjacency_.find(state);
+	if (it == adjacency_.end())
+		return;
+	for (std::size_t node : it->second)
+		enqueue(node);
+}
+
+void ConnectingPrivate::PendingPairs::enqueue(std::size_t node) {
+	Node& n = nodes_[node];
+	n.version += 1;
+	n.seq = seq_++;
+	queue_.push_back(Entry{ n.pair.first->priority(), n.pair.second->priority(), n.seq, node, n.version });
+	std::push_heap(queue_.begin(), queue_.end(), Later());
+	compact();
+}
+
+void ConnectingPrivate::PendingPairs::compact() {
+	// each pending pair has exactly one valid entry
+	if (queue_.size() <= 2 * size_)
+		return;
+	auto outdated = [this](const Entry& entry) {
+		const Node& node = nodes_[entry.node];
+		return !node.alive || entry.version != node.version;
+	};
+	queue_.erase(std::remove_if(queue_.begin(), queue_.end(), outdated), queue_.end());
+	std::make_heap(queue_.begin(), queue_.end(), Later());
+}
+
+void ConnectingPrivate::PendingPairs::cleanup() const {
+	while (!queue_.empty()) {
+		const Entry& entry = queue_.front();
+		const Node& node = nodes_[entry.node];
+		if (!node.alive || entry.version != node.version) {
+			std::pop_heap(queue_.begin(), queue_.end(), Later());
+			queue_.pop_back();  // outdated
+			continue;
+		}
+		if (entry.first == node.pair.first->priority() && entry.second == node.pair.second->priority())
+			return;  // valid top entry
+
+		// priorities changed without notice: re-queue
+		// (only catches degraded top entries, improvements need to be reported via update())
+		std::size_t index = entry.node;
+		std::pop_heap(queue_.begin(), queue_.end(), Later());
+		queue_.pop_back();
+		const_cast<PendingPairs*>(this)->enqueue(index);  // logically const: ranking is unchanged
+	}
+}
+
+const ConnectingPrivate::StatePair& ConnectingPrivate::PendingPairs::top() const {
+	assert(!empty());
+	cleanup();
+	return nodes_[queue_.front().node].pair;
+}
+
+ConnectingPrivate::StatePair ConnectingPrivate::PendingPairs::pop() {
+	assert(!empty());
+	cleanup();
+	std::size_t index = queue_.front().node;
+	std::pop_heap(queue_.begin(), queue_.end(), Later());
+	queue_.pop_back();
+
+	Node& node = nodes_[index];
+	node.alive = false;
+	free_.push_back(index);
+	--size_;
+	unlink(index, &*node.pair.first);
+	unlink(index, &*node.pair.second);
+	compact();
+	return node.pair;
+}
+
+void ConnectingPrivate::PendingPairs::unlink(std::size_t node, const InterfaceState* state) {
+	auto it = adjacency_.find(state);
+	assert(it != adjacency_.end());
+	auto& nodes = it->second;
+	nodes.erase(std::find(nodes.begin(), nodes.end(), node));
+	if (nodes.empty())
+		adjacency_.erase(it);
+}
+
+void ConnectingPrivate::PendingPairs::clear() {
+	nodes_.clear();
+	free_.clear();
+	adjacency_.clear();
+	queue_.clear();
+	size_ = 0;
+	seq_ = 0;
+}
+
+std::vector<ConnectingPrivate::StatePair> ConnectingPrivate::PendingPairs::pairsOf(const InterfaceState* state) const {
+	std::vector<StatePair> result;
+	auto it = adjacency_.find(state);
+	if (it != adjacency_.end()) {
+		result.reserve(it->second.size());
+		for (std::size_t node : it->second)
+			result.push_back(nodes_[node].pair);
+	}
+	return result;
+}
+
+std::vector<ConnectingPrivate::StatePair> ConnectingPrivate::PendingPairs::sorted() const {
+	std::vector<const Node*> alive;
+	alive.reserve(size_);
+	for (const Node& node : nodes_)
+		if (node.alive)
+			alive.push_back(&node);
+	std::sort(alive.begin(), alive.end(), [](const Node* a, const Node* b) { return a->seq < b->seq; });
+	std::stable_sort(alive.begin(), alive.end(), [](const Node* a, const Node* b) { return a->pair < b->pair; });
+
+	std::vector<StatePair> result;
+	result.reserve(alive.size());
+	for (const Node* node : alive)
+		result.push_back(node->pair);
+	return result;
+}
+
 template <Interface::Direction dir>
 void ConnectingPrivate::newState(Interface::iterator it, Interface::UpdateFlags updated) {
+	if (updated && propagating_[dir]) {
+		// update caused by propagation from this interface: only re-rank the state's pairs
+		updatePending(&*it);
+		return;
+	}
 	auto parent_pimpl = parent()->pimpl();
-	// disable current interface to break loop (jumping back and forth between both interfaces)
-	// this will be checked by notifyEnabled() below
-	Interface::DisableNotify disable_source_interface(*pullInterface<dir>());
+	// mark current interface to break loop (jumping back and forth between both interfaces)
+	struct Guard
+	{
+		bool& flag;
+		const bool old;
+		Guard(bool& f) : flag(f), old(f) { flag = true; }
+		~Guard() { flag = old; }
+	} guard(propagating_[dir]);
 	if (updated) {
 		if (updated.testFlag(Interface::STATUS) &&  // only perform these costly operations if needed
-		    pullInterface<opposite<dir>()>()->notifyEnabled())  // suppressing recursive loop?
+		    !propagating_[opposite<dir>()])  // suppressing recursive loop?
 		{
 			// If status has changed, propagate the update to the opposite side
 			auto status = it->priority().status();
 			if (status == InterfaceState::Status::PRUNED)  // PRUNED becomes ARMED on opposite side
 				status = InterfaceState::Status::ARMED;  // (only for pending state pairs)
 
-			for (const auto& candidate : this->pending) {
-				if (std::get<opposite<dir>()>(candidate) != it)  // only consider pairs with source state == state
-					continue;
+			// only consider pairs with source state == state
+			for (const auto& candidate : pending.pairsOf(&*it)) {
 				auto oit = std::get<dir>(candidate);  // opposite target state
 				auto ostatus = oit->priority().status();
 				if (ostatus != status) {
@@ -792,8 +1131,8 @@ void ConnectingPrivate::newState(Interface::iterator it, Interface::UpdateFlags
 			}
 		}
 
-		// many pairs will have changed priorities: resort pending list
-		pending.sort();
+		// re-rank pairs of the updated state
+		updatePending(&*it);
 	} else {  // new state: insert all pairs with other interface
 		assert(it->priority().enabled());  // new solutions are feasible, aren't they?
 		InterfacePtr other_interface = pullInterface<dir>();
@@ -802,6 +1141,8 @@ void ConnectingPrivate::newState(Interface::iterator it, Interface::UpdateFlags
 		// other interface states to re-enable (post-poned because otherwise order in other_interface changes during loop)
 		std::vector<Interface::iterator> oit_to_enable;
 		for (Interface::iterator oit = other_interface->begin(), oend = other_interface->end(); oit != oend; ++oit) {
+			if (!oit->scene())
+				continue;  // released by Task::collectPrunedBranches(), i.e. never re-enabled
 			if (!static_cast<Connecting*>(me_)->compatible(*it, *oit))
 				continue;
 
@@ -843,22 +1184,24 @@ void ConnectingPrivate::newState(Interface::iterator it, Interface::UpdateFlags
 #endif
 }
 
+void ConnectingPrivate::updatePending(const InterfaceState* state) {
+	pending.update(state);
+	for (PendingPairs* other : shared_pending_)
+		other->update(state);
+}
+
 // Check whether there are pending feasible states (other than source) that could connect to target.
 // If not, we exhausted all solution candidates for target and thus should mark it as failure.
 template <Interface::Direction dir>
 inline bool ConnectingPrivate::hasPendingOpposites(const InterfaceState* source, const InterfaceState* target) const {
-	for (const auto& candidate : this->pending) {
+	for (const auto& candidate : pending.pairsOf(target)) {
 		static_assert(Interface::FORWARD == 0 && Interface::BACKWARD == 1,
 		              "This code assumes FORWARD=0, BACKWARD=1. Don't change their order!");
 		const InterfaceState* src = &*std::get<dir>(candidate);
-		const InterfaceState* tgt = &*std::get<opposite<dir>()>(candidate);
+		assert(&*std::get<opposite<dir>()>(candidate) == target);
 
-		if (tgt == target && src != source && src->priority().enabled())
+		if (src != source && src->priority().enabled() && target->priority().enabled())
 			return true;
-
-		// early stopping when only infeasible pairs are to come
-		if (!std::get<0>(candidate)->priority().enabled() || !std::get<1>(candidate)->priority().enabled())
-			break;
 	}
 	return false;
 }
@@ -868,25 +1211,61 @@ template bool ConnectingPrivate::hasPendingOpposites<Interface::FORWARD>(const I
 template bool ConnectingPrivate::hasPendingOpposites<Interface::BACKWARD>(const InterfaceState* end,
                                                                           const InterfaceState* start) const;
 
+bool ConnectingPrivate::hasPendingPairs() const {
+	return !pending.empty() && pending.top().first->priority().enabled() &&
+	       pending.top().second->priority().enabled();
+}
+
 bool ConnectingPrivate::canCompute() const {
 	// ROS_DEBUG_STREAM("canCompute " << name() << ": " << pendingPairsPrinter());
-	// Do we still have feasible pending state pairs?
-	return !pending.empty() && pending.front().first->priority().enabled() &&
-	       pending.front().second->priority().enabled();
+	return (acceptsRequests() && hasPendingPairs()) || hasPendingRequests();
+}
+
+InterfaceState::Priority ConnectingPrivate::pendingPriority() const {
+	if (pending.empty())
+		return noPendingPriority();
+	const StatePair& top = pending.top();
+	return top.first->priority() + top.second->priority();
 }
 
 void ConnectingPrivate::compute() {
-	const StatePair& top = pending.pop();
-	const InterfaceState& from = *top.first;
-	const InterfaceState& to = *top.second;
-	assert(from.priority().enabled() && to.priority().enabled());
-	static_cast<Connecting*>(me_)->compute(from, to);
+	bool finished = finishReadyRequests() > 0;
+	if (!acceptsRequests() || !hasPendingPairs()) {
+		if (!finished && hasPendingRequests())  // nothing else to do: wait for a pending request
+			finishOldestRequest();
+		return;
+	}
+
+	Connecting* me = static_cast<Connecting*>(me_);
+	// a pair became pending when the later of both states arrived
+	auto record_wait = [this, now = std::chrono::steady_clock::now()](const StatePair& pair) {
+		telemetry_.recordWait(std::max(pair.first->enqueueTime(), pair.second->enqueueTime()), now);
+	};
+	std::size_t batch_size = me->batchSize();
+	if (batch_size <= 1) {
+		const StatePair top = pending.pop();
+		record_wait(top);
+		const InterfaceState& from = *top.first;
+		const InterfaceState& to = *top.second;
+		assert(from.priority().enabled() && to.priority().enabled());
+		me->compute(from, to);
+		return;
+	}
+
+	// process several top-priority pairs at once
+	Connecting::StatePairs pairs;
+	while (pairs.size() < batch_size && hasPendingPairs()) {
+		const StatePair top = pending.pop();
+		record_wait(top);
+		pairs.emplace_back(&*top.first, &*top.second);
+	}
+	me->computeBatch(pairs);
 }
 
 std::ostream& operator<<(std::ostream& os, const PendingPairsPrinter& p) {
 	const auto* impl = p.instance_;
 	const char* reset = InterfaceState::colorForStatus(3);
-	for (const auto& candidate : impl->pending) {
+	for (const auto& candidate : impl->pending.sorted()) {
 		size_t first = getIndex(*impl->starts(), candidate.first);
 		size_t second = getIndex(*impl->ends(), candidate.second);
 		os << InterfaceState::colorForStatus(candidate.first->priority().status()) << first << reset << ":"
@@ -904,6 +1283,11 @@ void Connecting::reset() {
 	ComputeBase::reset();
 }
 
+void Connecting::computeBatch(const StatePairs& pairs) {
+	for (const auto& pair : pairs)
+		compute(*pair.first, *pair.second);
+}
+
 /// compare consistency of planning scenes
 bool Connecting::compatible(const InterfaceState& from_state, const InterfaceState& to_state) const {
 	const planning_scene::PlanningSceneConstPtr& from = from_state.scene();
@@ -35,7 +35,9 @@
 /* Authors: Robert Haschke, Michael Goerner */
 
 #include <moveit/task_constructor/stages/compute_ik.h>
+#include <moveit/task_constructor/container_p.h>
 #include <moveit/task_constructor/storage.h>
+#include <moveit/task_constructor/thread_pool.h>
 #include <moveit/task_constructor/marker_tools.h>
 #include <moveit/task_constructor/fmt_p.h>
 
@@ -46,8 +48,10 @@
 #include <Eigen/Geometry>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <rclcpp/logging.hpp>
 
 namespace moveit {
@@ -62,6 +66,9 @@ ComputeIK::ComputeIK(const std::string& name, Stage::pointer&& child) : WrapperB
 	p.declare<std::string>("group", "name of active group (derived from eef if not provided)");
 	p.declare<std::string>("default_pose", "", "default joint pose of active group (defines cost of IK)");
 	p.declare<uint32_t>("max_ik_solutions", 1);
+	p.declare<uint32_t>("num_ik_threads", 1,
+	                    "number of concurrent IK searches on the task's thread pool "
+	                    "(requires Task::setNumThreads() > 1)");
 	p.declare<bool>("ignore_collisions", false);
 	p.declare<double>("min_solution_distance", 0.1,
 	                  "minimum distance between seperate IK solutions for the same target");
@@ -101,6 +108,66 @@ using IKSolutions = std::vector<IKSolution>;
 
 namespace {
 
+// validate an IK solution, whose joint positions are already set in state, w.r.t. constraints and collisions
+void validateIKSolution(const planning_scene::PlanningScene& scene,
+                        const kinematic_constraints::KinematicConstraintSet& constraint_set, bool ignore_collisions,
+                        moveit::core::RobotState& state, const moveit::core::JointModelGroup* jmg,
+                        IKSolution& solution) {
+	// validate constraints
+	solution.satisfies_constraints = constraint_set.decide(state).satisfied;
+
+	// check for collisions
+	collision_detection::CollisionRequest req;
+	collision_detection::CollisionResult res;
+	req.contacts = true;
+	req.max_contacts = 1;
+	req.group_name = jmg->getName();
+	scene.checkCollision(req, res, state);
+	solution.collision_free = ignore_collisions || !res.collision;
+	solution.contacts = std::move(res.contacts);
+}
+
+/** Thread-safe collection of IK solutions found by concurrent IK searches
+ *
+ * New solutions are registered under a lock, rejecting those too close to previously found ones.
+ * The (expensive) validation of a registered solution is performed by the caller without holding the lock.
+ * Registered solutions are stored in a deque to keep their addresses stable.
+ */
+class IKSolutionCollector
+{
+public:
+	IKSolutionCollector(std::size_t max_solutions, double min_solution_distance)
+	  : max_solutions_(max_solutions), min_solution_distance_(min_solution_distance) {}
+
+	bool full() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return solutions_.size() >= max_solutions_;
+	}
+
+	/// register a new solution, returns nullptr if already full or too close to a previous solution
+	IKSolution* add(const moveit::core::JointModelGroup* jmg, const double* joint_positions) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (solutions_.size() >= max_solutions_)
+			return nullptr;
+		for (const auto& sol : solutions_) {
+			if (jmg->distance(joint_positions, sol.joint_positions.data()) < min_solution_distance_)
+				return nullptr;  // too close to already found solution
+		}
+		solutions_.emplace_back();
+		solutions_.back().joint_positions.assign(joint_positions, joint_positions + jmg->getVariableCount());
+		return &solutions_.back();
+	}
+
+	/// solutions in the order they were found (only to be called after all searches finished)
+	const std::deque<IKSolution>& solutions() const { return solutions_; }
+
+private:
+	const std::size_t max_solutions_;
+	const double min_solution_distance_;
+	mutable std::mutex mutex_;
+	std::deque<IKSolution> solutions_;
+};
+
 // ??? TODO: provide callback methods in PlanningScene class / probably not very useful here though...
 // TODO: move into MoveIt core, lift active_components_only_ from fcl to common interface
 bool isTargetPoseCollidingInEEF(const planning_scene::PlanningSceneConstPtr& scene,
@@ -205,7 +272,15 @@ void ComputeIK::init(const moveit::core::RobotModelConstPtr& robot_model) {
 
 	// all properties can be derived from the interface state
 	// however, if they are defined already now, we validate here
-	const auto& props = properties();
+	auto& props = properties();
+	timeout_ = props.handle<double>("timeout");
+	ignore_collisions_ = props.handle<bool>("ignore_collisions");
+	min_solution_distance_ = props.handle<double>("min_solution_distance");
+	max_ik_solutions_ = props.handle<uint32_t>("max_ik_solutions");
+	num_ik_threads_ = props.handle<uint32_t>("num_ik_threads");
+	if (num_ik_threads_.get() > 1 && !pimpl()->threadPool())
+		RCLCPP_WARN_STREAM(LOGGER, "'" << name() << "': num_ik_threads > 1 has no effect without a task thread pool. "
+		                                          "Use Task::setNumThreads() to create one.");
 	const moveit::core::JointModelGroup* eef_jmg = nullptr;
 	const moveit::core::JointModelGroup* jmg = nullptr;
 	std::string msg;
@@ -248,7 +323,7 @@ void ComputeIK::compute() {
 
 	const planning_scene::PlanningSceneConstPtr& scene{ s.start()->scene() };
 
-	const bool ignore_collisions = props.get<bool>("ignore_collisions");
+	const bool ignore_collisions = ignore_collisions_.get();
 	const auto& robot_model = scene->getRobotModel();
 	const moveit::core::JointModelGroup* eef_jmg = nullptr;
 	const moveit::core::JointModelGroup* jmg = nullptr;
@@ -367,101 +442,143 @@ void ComputeIK::compute() {
 	} else
 		scene->getCurrentState().copyJointGroupPositions(jmg, compare_pose);
 
-	double min_solution_distance = props.get<double>("min_solution_distance");
+	double min_solution_distance = min_solution_distance_.get();
 
 	kinematic_constraints::KinematicConstraintSet constraint_set(robot_model);
 	constraint_set.add(props.get<moveit_msgs::msg::Constraints>("constraints"), scene->getTransforms());
 
-	IKSolutions ik_solutions;
-	auto is_valid = [scene, ignore_collisions, min_solution_distance, &constraint_set = std::as_const(constraint_set),
-	                 &ik_solutions](moveit::core::RobotState* state, const moveit::core::JointModelGroup* jmg,
-	                                const double* joint_positions) {
-		for (const auto& sol : ik_solutions) {
-			if (jmg->distance(joint_positions, sol.joint_positions.data()) < min_solution_distance)
-				return false;  // too close to already found solution
-		}
-		state->setJointGroupPositions(jmg, joint_positions);
-		state->update();
+	// create a new scene for each solution as they will have different robot states
+	auto spawn_solution = [&](const IKSolution& ik_solution) {
+		planning_scene::PlanningScenePtr solution_scene = scene->diff();
+		SubTrajectory solution;
+		solution.setComment(s.comment());
+		std::copy(frame_markers.begin(), frame_markers.end(), std::back_inserter(solution.markers()));
 
-		ik_solutions.emplace_back();
-		auto& solution{ ik_solutions.back() };
-		state->copyJointGroupPositions(jmg, solution.joint_positions);
+		if (ik_solution.collision_free && ik_solution.satisfies_constraints)
+			// compute cost as distance to compare_pose
+			solution.setCost(s.cost() + jmg->distance(ik_solution.joint_positions.data(), compare_pose.data()));
+		else if (!ik_solution.collision_free) {  // solution was in collision
+			solution.markAsFailure("Collision between " + listCollisionPairs(ik_solution.contacts));
+			utils::addCollisionMarkers(solution.markers(), scene->getPlanningFrame(), ik_solution.contacts);
+		} else if (!ik_solution.satisfies_constraints) {  // solution was violating constraints
+			solution.markAsFailure("Constraints violated");
+		}
+		// set scene's robot state
+		moveit::core::RobotState& solution_state = solution_scene->getCurrentStateNonConst();
+		solution_state.setJointGroupPositions(jmg, ik_solution.joint_positions.data());
+		solution_state.update();
 
-		// validate constraints
-		solution.satisfies_constraints = constraint_set.decide(*state).satisfied;
+		InterfaceState state(solution_scene);
+		forwardProperties(*s.start(), state);
 
-		// check for collisions
-		collision_detection::CollisionRequest req;
-		collision_detection::CollisionResult res;
-		req.contacts = true;
-		req.max_contacts = 1;
-		req.group_name = jmg->getName();
-		scene->checkCollision(req, res, *state);
-		solution.collision_free = ignore_collisions || !res.collision;
-		solution.contacts = std::move(res.contacts);
+		// ik target link placement
+		std::copy(eef_markers.begin(), eef_markers.end(), std::back_inserter(solution.markers()));
 
-		return solution.satisfies_constraints && solution.collision_free;
+		spawn(std::move(state), std::move(solution));
 	};
 
-	uint32_t max_ik_solutions = props.get<uint32_t>("max_ik_solutions");
-	bool tried_current_state_as_seed = false;
+	uint32_t max_ik_solutions = max_ik_solutions_.get();
+	uint32_t num_ik_threads = num_ik_threads_.get();
+	bool found_any = false;
+
+	// A single solution is only searched from the current state as seed, which cannot be parallelized
+	if (num_ik_threads > 1 && max_ik_solutions > 1) {
+		IKSolutionCollector collector(max_ik_solutions, min_solution_distance);
+		auto is_valid = [&scene = std::as_const(*scene), ignore_collisions,
+		                 &constraint_set = std::as_const(constraint_set),
+		                 &collector](moveit::core::RobotState* state, const moveit::core::JointModelGroup* jmg,
+		                             const double* joint_positions) {
+			IKSolution* solution = collector.add(jmg, joint_positions);
+			if (!solution)
+				return collector.full();  // stop searching if enough solutions were found
+			state->setJointGroupPositions(jmg, joint_positions);
+			state->update();
+			validateIKSolution(scene, constraint_set, ignore_collisions, *state, jmg, *solution);
+			return solution->satisfies_constraints && solution->collision_free;
+		};
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout_.get());
+		// each search operates on its own copy of the robot state
+		auto search = [&, deadline](bool seed_from_current_state) {
+			moveit::core::RobotState seed_state{ scene->getCurrentState() };
+			while (!collector.full()) {
+				double remaining_time = std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count();
+				if (remaining_time <= 0)
+					break;
+				if (!seed_from_current_state) {
+					seed_state.setToRandomPositions(jmg);
+					seed_state.update();
+				}
+				seed_from_current_state = false;
+				auto iteration_timeout = std::min(remaining_time, jmg->getDefaultIKTimeout());
+				seed_state.setFromIK(jmg, target_pose, link->getName(), iteration_timeout, is_valid);
+			}
+		};
+
+		// run additional searches from random seeds on the task's thread pool, the first one starts in this thread
+		auto run_search = [&search](std::size_t i) { search(i == 0); };
+		if (ThreadPool* pool = pimpl()->threadPool())
+			pool->parallelFor(num_ik_threads, run_search);
+		else  // without a pool, the first search already runs until the deadline or enough solutions were found
+			run_search(0);
+
+		for (const auto& ik_solution : collector.solutions())
+			spawn_solution(ik_solution);
+		found_any = !collector.solutions().empty();
+	} else {
+		IKSolutions ik_solutions;
+		auto is_valid = [&scene = std::as_const(*scene), ignore_collisions, min_solution_distance,
+		                 &constraint_set = std::as_const(constraint_set),
+		                 &ik_solutions](moveit::core::RobotState* state, const moveit::core::JointModelGroup* jmg,
+		                                const double* joint_positions) {
+			for (const auto& sol : ik_solutions) {
+				if (jmg->distance(joint_positions, sol.joint_positions.data()) < min_solution_distance)
+					return false;  // too close to already found solution
+			}
+			state->setJointGroupPositions(jmg, joint_positions);
+			state->update();
+
+			ik_solutions.emplace_back();
+			auto& solution{ ik_solutions.back() };
+			state->copyJointGroupPositions(jmg, solution.joint_positions);
+			validateIKSolution(scene, constraint_set, ignore_collisions, *state, jmg, solution);
 
-	double remaining_time = timeout();
-	auto start_time = std::chrono::steady_clock::now();
-	while (ik_solutions.size() < max_ik_solutions && remaining_time > 0) {
-		if (tried_current_state_as_seed) {
-			sandbox_state.setToRandomPositions(jmg);
-			sandbox_state.update();
-		}
-		tried_current_state_as_seed = true;
-
-		size_t previous = ik_solutions.size();
-		auto iteration_timeout = std::min(remaining_time, jmg->getDefaultIKTimeout());
-		bool succeeded = sandbox_state.setFromIK(jmg, target_pose, link->getName(), iteration_timeout, is_valid);
-
-		auto now = std::chrono::steady_clock::now();
-		remaining_time -= std::chrono::duration<double>(now - start_time).count();
-		start_time = now;
-
-		// for all new solutions (successes and failures)
-		for (size_t i = previous; i != ik_solutions.size(); ++i) {
-			// create a new scene for each solution as they will have different robot states
-			planning_scene::PlanningScenePtr solution_scene = scene->diff();
-			SubTrajectory solution;
-			solution.setComment(s.comment());
-			std::copy(frame_markers.begin(), frame_markers.end(), std::back_inserter(solution.markers()));
-
-			if (ik_solutions[i].collision_free && ik_solutions[i].satisfies_constraints)
-				// compute cost as distance to compare_pose
-				solution.setCost(s.cost() + jmg->distance(ik_solutions[i].joint_positions.data(), compare_pose.data()));
-			else if (!ik_solutions[i].collision_free) {  // solution was in collision
-				solution.markAsFailure("Collision between " + listCollisionPairs(ik_solutions[i].contacts));
-				utils::addCollisionMarkers(solution.markers(), scene->getPlanningFrame(), ik_solutions[i].contacts);
-			} else if (!ik_solutions[i].satisfies_constraints) {  // solution was violating constraints
-				solution.markAsFailure("Constraints violated");
+			return solution.satisfies_constraints && solution.collision_free;
+		};
+
+		bool tried_current_state_as_seed = false;
+
+		double remaining_time = timeout_.get();
+		auto start_time = std::chrono::steady_clock::now();
+		while (ik_solutions.size() < max_ik_solutions && remaining_time > 0) {
+			if (tried_current_state_as_seed) {
+				sandbox_state.setToRandomPositions(jmg);
+				sandbox_state.update();
 			}
-			// set scene's robot state
-			moveit::core::RobotState& solution_state = solution_scene->getCurrentStateNonConst();
-			solution_state.setJointGroupPositions(jmg, ik_solutions[i].joint_positions.data());
-			solution_state.update();
+			tried_current_state_as_seed = true;
 
-			InterfaceState state(solution_scene);
-			forwardProperties(*s.start(), state);
+			size_t previous = ik_solutions.size();
+			auto iteration_timeout = std::min(remaining_time, jmg->getDefaultIKTimeout());
+			bool succeeded = sandbox_state.setFromIK(jmg, target_pose, link->getName(), iteration_timeout, is_valid);
 
-			// ik target link placement
-			std::copy(eef_markers.begin(), eef_markers.end(), std::back_inserter(solution.markers()));
+			auto now = std::chrono::steady_clock::now();
+			remaining_time -= std::chrono::duration<double>(now - start_time).count();
+			start_time = now;
 
-			spawn(std::move(state), std::move(solution));
-		}
+			// for all new solutions (successes and failures)
+			for (size_t i = previous; i != ik_solutions.size(); ++i)
+				spawn_solution(ik_solutions[i]);
 
-		// TODO: magic constant should be a property instead ("current_seed_only", or equivalent)
-		// Yeah, you are right, these are two different semantic concepts:
-		// One could also have multiple IK solutions derived from the same seed
-		if (!succeeded && max_ik_solutions == 1)
-			break;  // first and only attempt failed
+			// TODO: magic constant should be a property instead ("current_seed_only", or equivalent)
+			// Yeah, you are right, these are two different semantic concepts:
+			// One could also have multiple IK solutions derived from the same seed
+			if (!succeeded && max_ik_solutions == 1)
+				break;  // first and only attempt failed
+		}
+		found_any = !ik_solutions.empty();
 	}
 
-	if (ik_solutions.empty()) {  // failed to find any solution
+	if (!found_any) {  // failed to find any solution
 		planning_scene::PlanningScenePtr scene = s.start()->scene()->diff();
 		SubTrajectory solution;
 
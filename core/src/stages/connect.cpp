@@ -37,6 +37,7 @@
 */
 
 #include <moveit/task_constructor/stages/connect.h>
+#include <moveit/task_constructor/stage_p.h>
 #include <moveit/task_constructor/merge.h>
 #include <moveit/task_constructor/cost_terms.h>
 #include <moveit/task_constructor/fmt_p.h>
@@ -70,13 +71,15 @@ Connect::Connect(const std::string& name, const GroupPlannerVector& planners) :
 	                                         "constraints to maintain during trajectory");
 	properties().declare<TimeParameterizationPtr>("merge_time_parameterization",
 	                                              std::make_shared<TimeOptimalTrajectoryGeneration>());
+	p.declare<uint32_t>("max_concurrent_pairs", 1u, "number of pending state pairs planned concurrently");
 }
 
 void Connect::reset() {
 	Connecting::reset();
 	merged_jmg_.reset();
-	subsolutions_.clear();
-	states_.clear();
+	// release sub solutions and states, further ones are allocated from the (possibly renewed) arena
+	subsolutions_ = decltype(subsolutions_)(allocator<SubTrajectory>());
+	states_ = decltype(states_)(allocator<InterfaceState>());
 }
 
 void Connect::init(const core::RobotModelConstPtr& robot_model) {
@@ -110,6 +113,39 @@ void Connect::init(const core::RobotModelConstPtr& robot_model) {
 
 	if (errors)
 		throw errors;
+
+	initPlannerClones(robot_model);
+}
+
+void Connect::initPlannerClones(const core::RobotModelConstPtr& robot_model) {
+	// every concurrently planned pair beyond the first one requires its own set of planners
+	std::size_t num_clones = std::max(properties().get<uint32_t>("max_concurrent_pairs"), 1u) - 1;
+	if (planner_clones_.size() > num_clones)
+		planner_clones_.resize(num_clones);
+	bool cloneable = true;
+	while (cloneable && planner_clones_.size() < num_clones) {
+		GroupPlannerVector clones;
+		for (const GroupPlannerVector::value_type& pair : planner_) {
+			solvers::PlannerInterfacePtr clone = pair.second->clone();
+			if (!clone) {
+				RCLCPP_WARN_STREAM(LOGGER, fmt::format("{}: cannot clone planner '{}', limiting concurrent pairs to {}",
+				                                       name(), pair.second->getPlannerId(), planner_clones_.size() + 1));
+				cloneable = false;  // but still re-initialize existing clones below
+				break;
+			}
+			clones.emplace_back(pair.first, clone);
+		}
+		if (cloneable)
+			planner_clones_.push_back(std::move(clones));
+	}
+
+	// (re)initialize clones, using the current configuration of the original planners
+	for (GroupPlannerVector& clones : planner_clones_) {
+		for (std::size_t i = 0; i < clones.size(); ++i) {
+			clones[i].second->properties() = planner_[i].second->properties();
+			clones[i].second->init(robot_model);
+		}
+	}
 }
 
 bool Connect::compatible(const InterfaceState& from_state, const InterfaceState& to_state) const {
@@ -143,66 +179,184 @@ bool Connect::compatible(const InterfaceState& from_state, const InterfaceState&
 	return true;
 }
 
-void Connect::compute(const InterfaceState& from, const InterfaceState& to) {
-	const auto& props = properties();
-	double timeout = this->timeout();
-	MergeMode mode = props.get<MergeMode>("merge_mode");
-	double max_distance = props.get<double>("max_distance");
-	const auto& path_constraints = props.get<moveit_msgs::msg::Constraints>("path_constraints");
+// state of a (possibly asynchronous) connection attempt, planning the sub trajectories one after the other
+struct Connect::Attempt
+{
+	const InterfaceState* from;
+	const InterfaceState* to;
+	const GroupPlannerVector* planners;
+	double timeout;
+	MergeMode mode;
+	double max_distance;
+	moveit_msgs::msg::Constraints path_constraints;
 
-	const moveit::core::RobotState& final_goal_state = to.scene()->getCurrentState();
 	std::vector<PlannerIdTrajectoryPair> sub_trajectories;
-
 	std::vector<planning_scene::PlanningSceneConstPtr> intermediate_scenes;
-	planning_scene::PlanningSceneConstPtr start = from.scene();
-	intermediate_scenes.push_back(start);
-
 	bool success = false;
 	bool has_potential_collisions = false;
 	std::string comment = "No planners specified";
-	std::vector<double> positions;
-	for (const GroupPlannerVector::value_type& pair : planner_) {
-		// set intermediate goal state
-		planning_scene::PlanningScenePtr end = start->diff();
-		const moveit::core::JointModelGroup* jmg = final_goal_state.getJointModelGroup(pair.first);
+
+	bool done() const { return sub_trajectories.size() == planners->size(); }
+	const GroupPlannerVector::value_type& next() const { return (*planners)[sub_trajectories.size()]; }
+
+	// create intermediate goal scene for the next planner, only differing in the joints of its group
+	planning_scene::PlanningScenePtr nextGoal(const moveit::core::JointModelGroup*& jmg) const {
+		const moveit::core::RobotState& final_goal_state = to->scene()->getCurrentState();
+		planning_scene::PlanningScenePtr end = intermediate_scenes.back()->diff();
+		jmg = final_goal_state.getJointModelGroup(next().first);
+		std::vector<double> positions;
 		final_goal_state.copyJointGroupPositions(jmg, positions);
 		moveit::core::RobotState& goal_state = end->getCurrentStateNonConst();
 		goal_state.setJointGroupPositions(jmg, positions);
 		goal_state.update();
-		intermediate_scenes.push_back(end);
+		return end;
+	}
 
-		robot_trajectory::RobotTrajectoryPtr trajectory;
-		auto result = pair.second->plan(start, end, jmg, timeout, trajectory, path_constraints);
+	// store result of planning towards end, returns true to continue with next planner
+	bool add(const std::string& planner_id, const solvers::PlannerInterface::Result& result,
+	         const robot_trajectory::RobotTrajectoryPtr& trajectory, const planning_scene::PlanningSceneConstPtr& end,
+	         const moveit::core::JointModelGroup* jmg) {
+		intermediate_scenes.push_back(end);
+		sub_trajectories.push_back({ planner_id, trajectory });
 		success = bool(result);
-		sub_trajectories.push_back({ pair.second->getPlannerId(), trajectory });
 
 		if (!success) {
 			comment = result.message;
 			has_potential_collisions = trajectory && utils::hints_at_collisions(result);
-			break;
+			return false;
 		}
 
-		if (trajectory->getLastWayPoint().distance(goal_state, jmg) > max_distance) {
+		if (trajectory->getLastWayPoint().distance(end->getCurrentState(), jmg) > max_distance) {
 			success = false;
 			comment = "Trajectory end-point deviates too much from goal state";
-			break;
+			return false;
 		}
+		return true;
+	}
+};
 
-		// continue from reached state
-		start = end;
+Connect::AttemptPtr Connect::makeAttempt(const InterfaceState& from, const InterfaceState& to,
+                                         const GroupPlannerVector& planners) const {
+	const auto& props = properties();
+	auto attempt = std::make_shared<Attempt>();
+	attempt->from = &from;
+	attempt->to = &to;
+	attempt->planners = &planners;
+	attempt->timeout = this->timeout();
+	attempt->mode = props.get<MergeMode>("merge_mode");
+	attempt->max_distance = props.get<double>("max_distance");
+	attempt->path_constraints = props.get<moveit_msgs::msg::Constraints>("path_constraints");
+	attempt->intermediate_scenes.push_back(from.scene());
+	return attempt;
+}
+
+void Connect::compute(const InterfaceState& from, const InterfaceState& to) {
+	plan(makeAttempt(from, to, planner_));
+}
+
+std::size_t Connect::batchSize() const {
+	return std::min<std::size_t>(properties().get<uint32_t>("max_concurrent_pairs"), planner_clones_.size() + 1);
+}
+
+void Connect::computeBatch(const StatePairs& pairs) {
+	// each attempt uses its own set of planners
+	std::vector<AttemptPtr> attempts;
+	attempts.reserve(pairs.size());
+	for (std::size_t i = 0; i < pairs.size(); ++i)
+		attempts.push_back(makeAttempt(*pairs[i].first, *pairs[i].second, i == 0 ? planner_ : planner_clones_[i - 1]));
+
+	if (maxPendingRequests() > 0) {  // asynchronous mode: each attempt finishes individually
+		for (const AttemptPtr& attempt : attempts)
+			plan(attempt);
+		return;
+	}
+
+	// plan all attempts concurrently, segment by segment
+	struct Request
+	{
+		solvers::PlannerInterface::Future future;
+		planning_scene::PlanningScenePtr end;
+		const moveit::core::JointModelGroup* jmg;
+	};
+	std::vector<Attempt*> active;
+	for (const AttemptPtr& attempt : attempts) {
+		if (!attempt->done())
+			active.push_back(attempt.get());
 	}
+	std::vector<Request> requests;
+	while (!active.empty()) {
+		requests.clear();
+		for (Attempt* attempt : active) {
+			Request request;
+			request.end = attempt->nextGoal(request.jmg);
+			request.future =
+			    attempt->next().second->planAsync(pimpl()->threadPool(), attempt->intermediate_scenes.back(), request.end,
+			                                      request.jmg, attempt->timeout, attempt->path_constraints);
+			requests.push_back(std::move(request));
+		}
+		std::vector<Attempt*> continued;
+		for (std::size_t i = 0; i < active.size(); ++i) {
+			Attempt* attempt = active[i];
+			const auto& result = requests[i].future.get();
+			if (attempt->add(attempt->next().second->getPlannerId(), result.result, result.trajectory, requests[i].end,
+			                 requests[i].jmg) &&
+			    !attempt->done())
+				continued.push_back(attempt);
+		}
+		active.swap(continued);
+	}
+
+	// report results in priority order
+	for (const AttemptPtr& attempt : attempts)
+		finish(*attempt);
+}
+
+void Connect::plan(const AttemptPtr& attempt) {
+	while (!attempt->done()) {
+		const solvers::PlannerInterfacePtr& planner = attempt->next().second;
+		planning_scene::PlanningSceneConstPtr start = attempt->intermediate_scenes.back();
+		const moveit::core::JointModelGroup* jmg;
+		planning_scene::PlanningScenePtr end = attempt->nextGoal(jmg);
+
+		if (maxPendingRequests() > 0) {  // plan asynchronously, continuing once the planner has finished
+			auto future =
+			    planner->planAsync(pimpl()->threadPool(), start, end, jmg, attempt->timeout, attempt->path_constraints);
+			finishAsync([future]() { return future.ready(); }, [future]() { future.wait(); },
+			            [this, attempt, future, end, jmg, planner]() {
+				            const auto& result = future.get();
+				            if (attempt->add(planner->getPlannerId(), result.result, result.trajectory, end, jmg))
+					            plan(attempt);
+				            else
+					            finish(*attempt);
+			            },
+			            [future]() mutable { future.cancel(); });
+			return;
+		}
+
+		robot_trajectory::RobotTrajectoryPtr trajectory;
+		auto result = planner->plan(start, end, jmg, attempt->timeout, trajectory, attempt->path_constraints);
+		if (!attempt->add(planner->getPlannerId(), result, trajectory, end, jmg))
+			break;
+	}
+	finish(*attempt);
+}
+
+void Connect::finish(const Attempt& attempt) {
+	const InterfaceState& from = *attempt.from;
+	const InterfaceState& to = *attempt.to;
 
 	SolutionBasePtr solution;
-	if (success && mode != SEQUENTIAL)  // try to merge
-		solution = merge(sub_trajectories, intermediate_scenes, from.scene()->getCurrentState());
+	if (attempt.success && attempt.mode != SEQUENTIAL)  // try to merge
+		solution = merge(attempt.sub_trajectories, attempt.intermediate_scenes, from.scene()->getCurrentState());
 	if (!solution)  // success == false or merging failed: store sequentially
-		solution = makeSequential(sub_trajectories, intermediate_scenes, from, to);
-	if (!success) {  // error already during sequential planning
-		solution->markAsFailure(comment);
-		if (has_potential_collisions) {
+		solution = makeSequential(attempt.sub_trajectories, attempt.intermediate_scenes, from, to);
+	if (!attempt.success) {  // error already during sequential planning
+		solution->markAsFailure(attempt.comment);
+		if (attempt.has_potential_collisions) {
 			// add collision markers for last (failed) trajectory segment
 			auto sequence = std::dynamic_pointer_cast<SolutionSequence>(solution);
 			auto trajectory = dynamic_cast<const SubTrajectory*>(sequence->solutions().back())->trajectory();
+			const auto& start = attempt.intermediate_scenes[attempt.intermediate_scenes.size() - 2];
 			utils::addCollisionMarkers(solution->markers(), *trajectory, start);
 		}
 	}
@@ -244,7 +398,7 @@ Connect::makeSequential(const std::vector<PlannerIdTrajectoryPair>& sub_trajecto
 		start = end;  // end state becomes next start state
 	}
 
-	return std::make_shared<SolutionSequence>(std::move(sub_solutions));
+	return makeShared<SolutionSequence>(std::move(sub_solutions));
 }
 
 SubTrajectoryPtr Connect::merge(const std::vector<PlannerIdTrajectoryPair>& sub_trajectories,
@@ -252,8 +406,8 @@ SubTrajectoryPtr Connect::merge(const std::vector<PlannerIdTrajectoryPair>& sub_
                                 const moveit::core::RobotState& state) {
 	// no need to merge if there is only a single sub trajectory
 	if (sub_trajectories.size() == 1)
-		return std::make_shared<SubTrajectory>(sub_trajectories.at(0).trajectory, 0.0, std::string(""),
-		                                       sub_trajectories.at(0).planner_id);
+		return makeShared<SubTrajectory>(sub_trajectories.at(0).trajectory, 0.0, std::string(""),
+		                                 sub_trajectories.at(0).planner_id);
 
 	// split sub_trajectories into trajectories and joined planner_ids
 	std::string planner_ids;
@@ -278,7 +432,7 @@ SubTrajectoryPtr Connect::merge(const std::vector<PlannerIdTrajectoryPair>& sub_
 	                                              properties().get<moveit_msgs::msg::Constraints>("path_constraints")))
 		return SubTrajectoryPtr();
 
-	return std::make_shared<SubTrajectory>(trajectory, 0.0, std::string(""), planner_ids);
+	return makeShared<SubTrajectory>(trajectory, 0.0, std::string(""), planner_ids);
 }
 }  // namespace stages
 }  // namespace task_constructor
@@ -0,0 +1,84 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/task_constructor/stopping_criterion.h>
+#include <moveit/task_constructor/task.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace moveit {
+namespace task_constructor {
+
+bool CostThresholdCriterion::stop(const PlanningProgress& progress) {
+	return progress.num_solutions > 0 && progress.best_cost <= threshold_;
+}
+
+ConvergenceCriterion::ConvergenceCriterion(double min_improvement, double duration, std::size_t iterations,
+                                           double min_absolute_improvement)
+  : min_improvement_(min_improvement)
+  , min_absolute_improvement_(min_absolute_improvement)
+  , duration_(duration)
+  , iterations_(iterations) {
+	ConvergenceCriterion::reset();
+}
+
+void ConvergenceCriterion::reset() {
+	reference_cost_ = std::numeric_limits<double>::infinity();
+	reference_time_ = 0.0;
+	reference_iteration_ = 0;
+}
+
+bool ConvergenceCriterion::stop(const PlanningProgress& progress) {
+	if (progress.num_solutions == 0)
+		return false;  // nothing to converge yet
+
+	// first solution or significant improvement: restart observation period
+	// (the relative threshold vanishes for a reference cost of zero: fall back to the absolute one)
+	const double threshold = std::max(min_improvement_ * std::abs(reference_cost_), min_absolute_improvement_);
+	if (std::isinf(reference_cost_) || reference_cost_ - progress.best_cost > threshold) {
+		reference_cost_ = progress.best_cost;
+		reference_time_ = progress.elapsed_time;
+		reference_iteration_ = progress.iteration;
+		return false;
+	}
+	return progress.elapsed_time - reference_time_ >= duration_ ||
+	       progress.iteration - reference_iteration_ >= iterations_;
+}
+
+bool LowerBoundCriterion::stop(const PlanningProgress& progress) {
+	return progress.num_solutions > 0 && progress.task.pendingCostLowerBound() >= progress.best_cost - tolerance_;
+}
+}  // namespace task_constructor
+}  // namespace moveit
@@ -42,6 +42,8 @@
 #include <moveit/robot_state/conversions.hpp>
 #include <moveit/planning_scene/planning_scene.hpp>
 #include <assert.h>
+#include <algorithm>
+#include <limits>
 
 namespace moveit {
 namespace task_constructor {
@@ -99,7 +101,21 @@ void InterfaceState::updateStatus(Status status) {
 	updatePriority(InterfaceState::Priority(priority_, status));
 }
 
-Interface::Interface(const Interface::NotifyFunction& notify) : notify_(notify) {}
+Interface::Interface(const Interface::NotifyFunction& notify, Storage storage, std::size_t capacity)
+  : notify_(notify) {
+	setStorage(storage, capacity);
+}
+
+void Interface::setStorage(Storage storage, std::size_t capacity) {
+	if (storage == BOUNDED && capacity == 0)
+		throw std::runtime_error("bounded interface requires a non-zero capacity");
+	if (storage == BOUNDED && notify_)
+		throw std::runtime_error("bounded storage is not supported for interfaces notifying about updates");
+
+	storage_ = storage;
+	capacity_ = storage == BOUNDED ? capacity : 0;
+	setCompare(InterfaceStateLess{ storage == FIFO });
+}
 
 // Announce a new InterfaceState
 void Interface::add(InterfaceState& state) {
@@ -117,6 +133,8 @@ void Interface::add(InterfaceState& state) {
 	std::list<InterfaceState*> container;
 	Interface::iterator it = container.insert(container.end(), &state);
 	it->owner_ = this;
+	it->owner_it_ = it;
+	it->enqueue_time_ = std::chrono::steady_clock::now();
 
 	// if either incoming or outgoing is defined, derive priority from there
 	if (!state.incomingTrajectories().empty())
@@ -130,12 +148,29 @@ void Interface::add(InterfaceState& state) {
 
 	// move list node into interface's state list (sorted by priority)
 	moveFrom(it, container);
+	if (lowest_enabled_cost_ && it->priority_.enabled())
+		lowest_enabled_cost_ = std::min(*lowest_enabled_cost_, it->priority_.cost());
+
+	// drop lowest-priority state if capacity is exceeded
+	if (storage_ == BOUNDED && size() > capacity_) {
+		iterator last = std::prev(end());
+		InterfaceState* dropped = *last;
+		remove(last);
+		++num_dropped_;
+		if (dropped_)
+			dropped_(dropped);
+		if (dropped == &state)
+			return;  // new state didn't make it into the interface
+	}
+
 	// and finally call notify callback
 	if (notify_)
 		notify_(it, UpdateFlags());
 }
 
 Interface::container_type Interface::remove(iterator it) {
+	if (lowest_enabled_cost_ && it->priority().enabled() && it->priority().cost() <= *lowest_enabled_cost_)
+		lowest_enabled_cost_.reset();  // the removed state might have been the cheapest one
 	container_type result;
 	moveTo(it, result, result.end());
 	it->owner_ = nullptr;
@@ -147,11 +182,17 @@ void Interface::updatePriority(InterfaceState* state, const InterfaceState::Prio
 	if (priority == old_prio)
 		return;  // nothing to do
 
-	auto it = std::find(begin(), end(), state);  // find iterator to state
-	assert(it != end());  // state should be part of this interface
+	iterator it = find(state);  // state knows its position within this interface
 
 	state->priority_ = priority;  // update priority
-	update(it);  // update position in ordered list
+	if (lowest_enabled_cost_) {
+		if (old_prio.enabled() && old_prio.cost() <= *lowest_enabled_cost_)
+			lowest_enabled_cost_.reset();  // the cheapest state might have become more expensive or disabled
+		else if (priority.enabled())
+			lowest_enabled_cost_ = std::min(*lowest_enabled_cost_, priority.cost());
+	}
+	if (storage_ != FIFO || old_prio.status() != priority.status())
+		update(it);  // update position in ordered list
 
 	if (notify_) {
 		UpdateFlags updated(Update::ALL);
@@ -162,6 +203,19 @@ void Interface::updatePriority(InterfaceState* state, const InterfaceState::Prio
 	}
 }
 
+double Interface::lowestEnabledCost() const {
+	if (!lowest_enabled_cost_) {
+		double lowest = std::numeric_limits<double>::infinity();
+		for (const InterfaceState* state : *this) {
+			if (!state->priority().enabled())
+				break;  // enabled states come first
+			lowest = std::min(lowest, state->priority().cost());
+		}
+		lowest_enabled_cost_ = lowest;
+	}
+	return *lowest_enabled_cost_;
+}
+
 std::ostream& operator<<(std::ostream& os, const Interface& interface) {
 	if (interface.empty())
 		os << "---";
@@ -208,7 +262,8 @@ void SolutionBase::markAsFailure(const std::string& msg) {
 
 void SolutionBase::toMsg(moveit_task_constructor_msgs::msg::Solution& msg, Introspection* introspection) const {
 	appendTo(msg, introspection);
-	start()->scene()->getPlanningSceneMsg(msg.start_scene);
+	if (start()->scene())  // scene might have been released for pruned branches
+		start()->scene()->getPlanningSceneMsg(msg.start_scene);
 }
 
 void SolutionBase::fillInfo(moveit_task_constructor_msgs::msg::SolutionInfo& info, Introspection* introspection) const {
@@ -240,6 +295,8 @@ void SubTrajectory::appendTo(moveit_task_constructor_msgs::msg::Solution& msg, I
 	if (trajectory())
 		trajectory()->getRobotTrajectoryMsg(t.trajectory);
 
+	if (!this->end()->scene())  // released for pruned branches
+		return;
 	if (this->end()->scene()->getParent() == this->start()->scene() ||  // diff
 	    this->end()->scene() == this->start()->scene())  // identical (from generator)
 		this->end()->scene()->getPlanningSceneDiffMsg(t.scene_diff);
@@ -251,8 +308,59 @@ double SubTrajectory::computeCost(const CostTerm& f, std::string& comment) const
 	return f(*this, comment);
 }
 
+const SolutionBase* SolutionSequence::Solutions::operator[](std::size_t index) const {
+	assert(index < size_);
+	for (const Segment& segment : segments_) {
+		if (index < segment->size())
+			return (*segment)[index];
+		index -= segment->size();
+	}
+	return nullptr;
+}
+
+SolutionSequence::SolutionSequence(container_type&& subsolutions, double cost, Stage* creator)
+  : SolutionBase(creator, cost), size_(subsolutions.size()) {
+	if (!subsolutions.empty()) {
+		tail_ = std::make_shared<container_type>(std::move(subsolutions));
+		segments_.push_back(tail_);
+	}
+}
+
+SolutionSequence::SolutionSequence(Segments&& segments, double cost, Stage* creator)
+  : SolutionBase(creator, cost), segments_(std::move(segments)) {
+	// drop empty segments, such that iteration can safely advance to the next segment
+	segments_.erase(std::remove_if(segments_.begin(), segments_.end(),
+	                               [](const Segment& segment) { return !segment || segment->empty(); }),
+	                segments_.end());
+	for (const Segment& segment : segments_)
+		size_ += segment->size();
+}
+
+SolutionSequence::SolutionSequence(const SolutionSequence& other)
+  : SolutionBase(other), segments_(other.segments_), size_(other.size_) {
+	// other might still extend its tail: use a private copy
+	if (other.tail_) {
+		tail_ = std::make_shared<container_type>(*other.tail_);
+		segments_.back() = tail_;
+	}
+}
+
+SolutionSequence& SolutionSequence::operator=(SolutionSequence other) {
+	SolutionBase::operator=(std::move(other));
+	segments_ = std::move(other.segments_);
+	tail_ = std::move(other.tail_);
+	size_ = other.size_;
+	return *this;
+}
+
 void SolutionSequence::push_back(const SolutionBase& solution) {
-	subsolutions_.push_back(&solution);
+	// shared segments are immutable: start an own tail segment if there is none yet
+	if (!tail_) {
+		tail_ = std::make_shared<container_type>();
+		segments_.push_back(tail_);
+	}
+	tail_->push_back(&solution);
+	++size_;
 }
 
 void SolutionSequence::appendTo(moveit_task_constructor_msgs::msg::Solution& msg, Introspection* introspection) const {
@@ -263,9 +371,9 @@ void SolutionSequence::appendTo(moveit_task_constructor_msgs::msg::Solution& msg
 	// However, the Connect stage will announce sub solutions created by itself
 	// (only in case of merge failure). To not confuse the display's SolutionModel
 	// we do not publish own IDs for them, but set those IDs to zero.
-	sub_msg.sub_solution_id.reserve(subsolutions_.size());
+	sub_msg.sub_solution_id.reserve(size_);
 	if (introspection) {
-		for (const SolutionBase* s : subsolutions_) {
+		for (const SolutionBase* s : solutions()) {
 			// skip sub solutions with same creator as this
 			if (s->creator() == this->creator())
 				continue;
@@ -274,8 +382,8 @@ void SolutionSequence::appendTo(moveit_task_constructor_msgs::msg::Solution& msg
 		msg.sub_solution.push_back(sub_msg);
 	}
 
-	msg.sub_trajectory.reserve(msg.sub_trajectory.size() + subsolutions_.size());
-	for (const SolutionBase* s : subsolutions_) {
+	msg.sub_trajectory.reserve(msg.sub_trajectory.size() + size_);
+	for (const SolutionBase* s : solutions()) {
 		size_t current = msg.sub_trajectory.size();
 		s->appendTo(msg, introspection);
 
@@ -43,15 +43,72 @@
 
 #include <moveit/robot_model_loader/robot_model_loader.hpp>
 #include <moveit/planning_pipeline/planning_pipeline.hpp>
+#include <moveit/planning_scene/planning_scene.hpp>
 
 #include <scope_guard/scope_guard.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <map>
 
 using namespace std::chrono_literals;
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_task_constructor.task");
 
 namespace {
+// Validate solutions in their original scenes updated by a scene diff
+// the parts of a scene diff to apply to existing states:
+// the robot state (including attached objects) of a diff, e.g. from a monitor, must not replace the states' own ones
+moveit_msgs::msg::PlanningScene environmentDiff(const moveit_msgs::msg::PlanningScene& scene_diff) {
+	moveit_msgs::msg::PlanningScene result;
+	result.is_diff = true;
+	result.robot_state.is_diff = true;
+	result.world = scene_diff.world;
+	result.allowed_collision_matrix = scene_diff.allowed_collision_matrix;
+	result.object_colors = scene_diff.object_colors;
+	return result;
+}
+
+class SolutionValidator
+{
+public:
+	explicit SolutionValidator(const moveit_msgs::msg::PlanningScene& scene_diff) : scene_diff_(scene_diff) {}
+
+	bool valid(const moveit::task_constructor::SolutionBase& solution) {
+		using namespace moveit::task_constructor;
+		// sub solutions shared between several solutions are validated only once
+		auto it = cache_.find(&solution);
+		if (it != cache_.end())
+			return it->second;
+
+		bool result = true;
+		if (const auto* sequence = dynamic_cast<const SolutionSequence*>(&solution)) {
+			for (const SolutionBase* sub : sequence->solutions())
+				if (!(result = valid(*sub)))
+					break;
+		} else if (const auto* wrapped = dynamic_cast<const WrappedSolution*>(&solution))
+			result = valid(*wrapped->wrapped());
+		else if (const auto* sub = dynamic_cast<const SubTrajectory*>(&solution))
+			result = valid(*sub);
+		return cache_[&solution] = result;
+	}
+
+private:
+	bool valid(const moveit::task_constructor::SubTrajectory& sub) {
+		// without a trajectory, validate the resulting state only
+		const auto& trajectory = sub.trajectory();
+		const auto& original = (trajectory ? sub.start() : sub.end())->scene();
+		if (!original)
+			return true;  // scenes of pruned branches might be released already: nothing to validate
+		planning_scene::PlanningScenePtr scene = original->diff();
+		scene->setPlanningSceneDiffMsg(scene_diff_);
+		return trajectory ? scene->isPathValid(*trajectory) : !scene->isStateColliding();
+	}
+
+	const moveit_msgs::msg::PlanningScene& scene_diff_;
+	std::map<const moveit::task_constructor::SolutionBase*, bool> cache_;
+};
+
 std::string rosNormalizeName(const std::string& name) {
 	std::string n;
 	n.reserve(name.size());
@@ -75,7 +132,9 @@ namespace moveit {
 namespace task_constructor {
 
 TaskPrivate::TaskPrivate(Task* me, const std::string& ns)
-  : WrapperBasePrivate(me, std::string()), ns_(rosNormalizeName(ns)), preempt_requested_(false) {}
+  : WrapperBasePrivate(me, std::string()), ns_(rosNormalizeName(ns)), preempt_requested_(false), num_threads_(1) {
+	setArena(std::make_shared<Arena>());
+}
 
 TaskPrivate& TaskPrivate::operator=(TaskPrivate&& other) {
 	this->WrapperBasePrivate::operator=(std::move(other));
@@ -83,6 +142,10 @@ TaskPrivate& TaskPrivate::operator=(TaskPrivate&& other) {
 	robot_model_ = std::move(other.robot_model_);
 	robot_model_loader_ = std::move(other.robot_model_loader_);
 	task_cbs_ = std::move(other.task_cbs_);
+	stopping_criteria_ = std::move(other.stopping_criteria_);
+	num_threads_ = other.num_threads_;
+	collect_pruned_branches_ = other.collect_pruned_branches_;
+	thread_pool_ = std::move(other.thread_pool_);
 	// Ensure same introspection status, but keep the existing introspection instance,
 	// which stores this task pointer and includes it in its task_id_
 	static_cast<Task*>(me_)->enableIntrospection(static_cast<bool>(other.introspection_));
@@ -93,6 +156,16 @@ const ContainerBase* TaskPrivate::stages() const {
 	return children().empty() ? nullptr : static_cast<ContainerBase*>(children().front().get());
 }
 
+void TaskPrivate::provideArena(const ArenaPtr& arena) {
+	setArena(arena);
+	traverseStages(
+	    [&arena](Stage& stage, int /*depth*/) {
+		    stage.pimpl()->setArena(arena);
+		    return true;
+	    },
+	    1, UINT_MAX);
+}
+
 Task::Task(const std::string& ns, bool introspection, ContainerBase::pointer&& container)
   : WrapperBase(new TaskPrivate(this, ns), std::move(container)) {
 	setTimeout(std::numeric_limits<double>::max());
@@ -144,10 +217,12 @@ void Task::loadRobotModel(const rclcpp::Node::SharedPtr& node, const std::string
 }
 
 void Task::add(Stage::pointer&& stage) {
+	pimpl()->initialized_ = false;
 	stages()->add(std::move(stage));
 }
 
 void Task::insert(Stage::pointer&& stage, int before) {
+	pimpl()->initialized_ = false;
 	stages()->insert(std::move(stage), before);
 }
 
@@ -158,8 +233,10 @@ void Task::clear() {
 
 void Task::enableIntrospection(bool enable) {
 	auto impl = pimpl();
-	if (enable && !impl->introspection_)
+	if (enable && !impl->introspection_) {
 		impl->introspection_.reset(new Introspection(impl));
+		impl->initialized_ = false;  // stages receive the instance in init()
+	}
 	else if (!enable && impl->introspection_) {
 		// reset introspection instance of all stages
 		impl->setIntrospection(nullptr);
@@ -173,6 +250,18 @@ void Task::enableIntrospection(bool enable) {
 	}
 }
 
+void Task::setNumThreads(size_t num_threads) {
+	auto impl = pimpl();
+	num_threads = std::max<size_t>(num_threads, 1);
+	if (num_threads != impl->num_threads_)
+		impl->initialized_ = false;  // thread pool is (re)created by init()
+	impl->num_threads_ = num_threads;
+}
+
+size_t Task::numThreads() const {
+	return pimpl()->num_threads_;
+}
+
 Introspection& Task::introspection() {
 	auto impl = pimpl();
 	enableIntrospection(true);
@@ -189,13 +278,53 @@ void Task::eraseTaskCallback(TaskCallbackList::const_iterator which) {
 	pimpl()->task_cbs_.erase(which);
 }
 
+void Task::addStoppingCriterion(const StoppingCriterionPtr& criterion) {
+	pimpl()->stopping_criteria_.push_back(criterion);
+}
+
+void Task::clearStoppingCriteria() {
+	pimpl()->stopping_criteria_.clear();
+}
+
+double Task::pendingCostLowerBound() const {
+	double bound = std::numeric_limits<double>::infinity();
+	stages()->traverseRecursively([&bound](const Stage& stage, unsigned int /*depth*/) {
+		const StagePrivate* impl = stage.pimpl();
+		// full solutions of a lazily enumerating SerialContainer are pending until lifted
+		if (const auto* serial = dynamic_cast<const SerialContainerPrivate*>(impl))
+			bound = std::min(bound, serial->candidatesCostLowerBound());
+		// containers just forward pending states to their children
+		if (dynamic_cast<const ContainerBasePrivate*>(impl) || !impl->canCompute())
+			return true;
+
+		bool pending = false;
+		for (const InterfaceConstPtr& interface : { impl->starts(), impl->ends() }) {
+			if (!interface)
+				continue;
+			if (interface->empty() || !interface->front()->priority().enabled())
+				continue;  // enabled states come first
+			pending = true;
+			// cached by the interface: don't scan all states in every planning iteration
+			bound = std::min(bound, interface->lowestEnabledCost());
+		}
+		if (!pending)  // stage computes without a known partial solution, e.g. a generator
+			bound = std::min(bound, impl->newSolutionCostLowerBound());
+		return true;
+	});
+	return bound;
+}
+
 void Task::reset() {
 	auto impl = pimpl();
 	// signal introspection, that this task was reset
 	if (impl->introspection_)
 		impl->introspection_->reset();
 
+	// stages release their states and solutions on reset and allocate new ones from a fresh arena,
+	// the old arena is released as a whole once all its objects are gone
+	impl->provideArena(std::make_shared<Arena>());
 	WrapperBase::reset();
+	impl->initialized_ = false;
 }
 
 void Task::init() {
@@ -208,17 +337,40 @@ void Task::init() {
 	child->setPrevEnds(impl->pendingBackward());
 	child->setNextStarts(impl->pendingForward());
 
+	// provide the task's arena to all stages before they create any states
+	impl->provideArena(ArenaPtr(impl->arena()));
+
+	// (re)create thread pool if concurrent computation was requested
+	if (impl->num_threads_ < 2)
+		impl->thread_pool_.reset();
+	else if (!impl->thread_pool_ || impl->thread_pool_->size() != impl->num_threads_)
+		impl->thread_pool_ = std::make_shared<ThreadPool>(impl->num_threads_);
+	// stages may validate their concurrency settings against the thread pool during init()
+	auto* thread_pool = impl->thread_pool_.get();
+	impl->traverseStages(
+	    [thread_pool](Stage& stage, int /*depth*/) {
+		    stage.pimpl()->setThreadPool(thread_pool);
+		    return true;
+	    },
+	    1, UINT_MAX);
+
 	// and *afterwards* initialize all children recursively
 	stages()->init(impl->robot_model_);
 	// task expects its wrapped child to push to both ends, this triggers interface resolution
 	stages()->pimpl()->resolveInterface(InterfaceFlags({ GENERATE }));
 
-	// provide introspection instance and preempt_requested to all stages
+	// provide introspection instance, thread pool, and preempt_requested to all stages
+	// (again, as interface resolution might have replaced their implementation)
+	// as well as collect_pruned_branches to all containers
 	auto* introspection = impl->introspection_.get();
+	impl->setCollectPrunedMember(&impl->collect_pruned_branches_);
 	impl->traverseStages(
-	    [introspection, impl](Stage& stage, int /*depth*/) {
+	    [introspection, thread_pool, impl](Stage& stage, int /*depth*/) {
 		    stage.pimpl()->setIntrospection(introspection);
+		    stage.pimpl()->setThreadPool(thread_pool);
 		    stage.pimpl()->setPreemptRequestedMember(&impl->preempt_requested_);
+		    if (auto* container = dynamic_cast<ContainerBasePrivate*>(stage.pimpl()))
+			    container->setCollectPrunedMember(&impl->collect_pruned_branches_);
 		    return true;
 	    },
 	    1, UINT_MAX);
@@ -226,6 +378,7 @@ void Task::init() {
 	// first time publish task
 	if (introspection)
 		introspection->publishTaskDescription();
+	impl->initialized_ = true;
 }
 
 bool Task::canCompute() const {
@@ -241,11 +394,15 @@ void Task::compute() {
 }
 
 moveit::core::MoveItErrorCode Task::plan(size_t max_solutions) {
+	init();
+	return resumePlanning(max_solutions);
+}
+
+moveit::core::MoveItErrorCode Task::resumePlanning(size_t max_solutions) {
 	// ensure the preempt request is resetted once this method exits
 	auto guard = sg::make_scope_guard([this]() noexcept { this->resetPreemptRequest(); });
 
 	auto impl = pimpl();
-	init();
 
 	// Print state and return success if there are solutions otherwise the input error_code
 	const auto success_or = [this](const int32_t error_code) -> int32_t {
@@ -257,20 +414,88 @@ moveit::core::MoveItErrorCode Task::plan(size_t max_solutions) {
 	};
 	const double available_time = timeout();
 	const auto start_time = std::chrono::steady_clock::now();
+	for (const auto& criterion : impl->stopping_criteria_)
+		criterion->reset();
+	const auto stopping_criterion_met = [this, impl, &start_time](std::size_t iteration) {
+		if (impl->stopping_criteria_.empty())
+			return false;
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+		const double best_cost = numSolutions() ? solutions().front()->cost() : std::numeric_limits<double>::infinity();
+		const PlanningProgress progress{ *this, iteration, elapsed, numSolutions(), best_cost };
+		// evaluate all criteria, as they might track progress
+		bool stop = false;
+		for (const auto& criterion : impl->stopping_criteria_)
+			stop |= criterion->stop(progress);
+		return stop;
+	};
+	std::size_t iteration = 0;
 	while (canCompute() && (max_solutions == 0 || numSolutions() < max_solutions)) {
 		if (impl->preempt_requested_)
 			return success_or(moveit::core::MoveItErrorCode::PREEMPTED);
 		if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() >= available_time)
 			return success_or(moveit::core::MoveItErrorCode::TIMED_OUT);
 		compute();
+		if (impl->collect_pruned_branches_)
+			collectPrunedBranches();
 		for (const auto& cb : impl->task_cbs_)
 			cb(*this);
 		if (impl->introspection_)
 			impl->introspection_->publishTaskState();
+		if (stopping_criterion_met(++iteration)) {
+			RCLCPP_DEBUG_STREAM(LOGGER, name() << ": stopping criterion met after " << iteration << " iterations");
+			break;
+		}
 	};
 	return success_or(moveit::core::MoveItErrorCode::PLANNING_FAILED);
 }
 
+size_t Task::revalidate(const moveit_msgs::msg::PlanningScene& scene_diff) {
+	auto impl = pimpl();
+	const moveit_msgs::msg::PlanningScene env_diff = environmentDiff(scene_diff);
+	SolutionValidator validator(env_diff);
+	size_t discarded = stages()->pimpl()->invalidateSolutions(
+	    [&validator](const SolutionBase& s) { return !validator.valid(s); }, "invalid in updated planning scene");
+
+	// planning continues from the remaining states, thus apply the diff to their scenes as well
+	std::map<const planning_scene::PlanningScene*, planning_scene::PlanningSceneConstPtr> updated;
+	impl->updateScenes([&updated, &env_diff](const planning_scene::PlanningSceneConstPtr& scene) {
+		auto& result = updated[scene.get()];  // scenes shared by several states are updated only once
+		if (!result) {
+			planning_scene::PlanningScenePtr diff = scene->diff();
+			diff->setPlanningSceneDiffMsg(env_diff);
+			result = diff;
+		}
+		return result;
+	});
+
+	if (discarded) {
+		RCLCPP_DEBUG_STREAM(LOGGER, name() << ": discarded " << discarded << " solutions invalid in updated scene");
+		if (impl->introspection_)
+			impl->introspection_->publishTaskState();
+	}
+	return numSolutions();
+}
+
+moveit::core::MoveItErrorCode Task::replan(const moveit_msgs::msg::PlanningScene& scene_diff, size_t max_solutions) {
+	revalidate(scene_diff);
+	if (!pimpl()->initialized_)  // stage graph was modified since: nothing to resume
+		return plan(max_solutions);
+	// continue planning from the surviving solutions and states:
+	// init() would reset the stages' internal planning state (e.g. the current job of Fallbacks)
+	return resumePlanning(max_solutions);
+}
+
+size_t Task::collectPrunedBranches() {
+	size_t released = pimpl()->collectPrunedBranches();
+	if (released)
+		RCLCPP_DEBUG_STREAM(LOGGER, name() << ": released " << released << " states of pruned branches");
+	return released;
+}
+
+void Task::setCollectPrunedBranches(bool enable) {
+	pimpl()->collect_pruned_branches_ = enable;
+}
+
 void Task::preempt() {
 	pimpl()->preempt_requested_ = true;
 }
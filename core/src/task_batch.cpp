@@ -0,0 +1,192 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:    Plan many structurally identical tasks concurrently
+*/
+
+#include <moveit/task_constructor/task_batch.h>
+#include <moveit/task_constructor/cost_terms.h>
+#include <moveit/task_constructor/thread_pool.h>
+
+#include <rclcpp/logging.hpp>
+#include <scope_guard/scope_guard.hpp>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <tuple>
+
+namespace moveit {
+namespace task_constructor {
+
+namespace {
+const rclcpp::Logger LOGGER = rclcpp::get_logger("TaskBatch");
+
+/// generator spawning the start scene of the currently processed request
+class StartState : public Generator
+{
+public:
+	StartState() : Generator("start") { setCostTerm(std::make_unique<cost::Constant>(0.0)); }
+
+	void setScene(planning_scene::PlanningSceneConstPtr scene) { scene_ = std::move(scene); }
+
+	void reset() override {
+		Generator::reset();
+		ran_ = false;
+	}
+	bool canCompute() const override { return !ran_ && scene_; }
+	void compute() override {
+		spawn(InterfaceState(scene_), SubTrajectory());
+		ran_ = true;
+	}
+
+private:
+	planning_scene::PlanningSceneConstPtr scene_;
+	bool ran_ = false;
+};
+}  // namespace
+
+struct TaskBatch::Worker
+{
+	Task task;
+	StartState* start;
+
+	explicit Worker(std::size_t index) : task("batch_" + std::to_string(index), false) {}
+};
+
+TaskBatch::TaskBatch(const moveit::core::RobotModelConstPtr& robot_model, const TaskFactory& factory,
+                     std::size_t num_workers) {
+	if (num_workers == 0)
+		num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+	workers_.reserve(num_workers);
+	for (std::size_t i = 0; i < num_workers; ++i) {
+		auto worker = std::make_unique<Worker>(i);
+		worker->task.setRobotModel(robot_model);
+		auto start = std::make_unique<StartState>();
+		worker->start = start.get();
+		worker->task.add(std::move(start));
+		factory(worker->task);
+		workers_.push_back(std::move(worker));
+	}
+	// the calling thread serves as the first worker
+	if (num_workers > 1)
+		thread_pool_ = std::make_shared<ThreadPool>(num_workers - 1);
+}
+
+TaskBatch::~TaskBatch() = default;
+
+Task& TaskBatch::task(std::size_t worker) {
+	return workers_.at(worker)->task;
+}
+
+std::vector<TaskBatch::Result> TaskBatch::plan(const std::vector<Request>& requests, std::size_t max_solutions) {
+	preempt_requested_ = false;
+	std::vector<Result> results(requests.size());
+
+	// each worker fetches the next unprocessed request until all are done
+	std::atomic<std::size_t> next{ 0 };
+	auto work = [this, &requests, &results, &next, max_solutions](Worker& worker) {
+		for (std::size_t i = next++; i < requests.size(); i = next++) {
+			if (preempt_requested_)
+				results[i].error_code = moveit::core::MoveItErrorCode::PREEMPTED;
+			else
+				results[i] = plan(worker, requests[i], max_solutions);
+		}
+	};
+
+	std::vector<std::future<void>> jobs;
+	jobs.reserve(workers_.size() - 1);
+	for (std::size_t i = 1; i < workers_.size(); ++i)
+		jobs.push_back(thread_pool_->submit([&work, &worker = *workers_[i]]() { work(worker); }));
+	work(*workers_.front());
+	for (auto& job : jobs)
+		job.get();
+
+	return results;
+}
+
+TaskBatch::Result TaskBatch::plan(Worker& worker, const Request& request, std::size_t max_solutions) {
+	Task& task = worker.task;
+	task.reset();
+	worker.start->setScene(request.scene);
+
+	// set request's properties, restoring previous values (default, current) afterwards
+	PropertyMap& props = task.properties();
+	std::vector<std::tuple<Property*, boost::any, boost::any>> previous;
+	previous.reserve(request.properties.size());
+	auto restore = sg::make_scope_guard([&previous]() noexcept {
+		for (auto& [property, default_value, value] : previous) {
+			property->setDefaultValue(default_value);
+			property->setCurrentValue(value);
+		}
+	});
+
+	Result result;
+	try {
+		for (const auto& [name, value] : request.properties) {
+			if (props.hasProperty(name)) {
+				Property& property = props.property(name);
+				previous.emplace_back(&property, property.defaultValue(),
+				                      property.defined() ? property.value() : boost::any());
+				property.setValue(value);
+			} else {
+				props.set(name, value);
+				previous.emplace_back(&props.property(name), boost::any(), boost::any());
+			}
+		}
+
+		result.error_code = task.plan(max_solutions);
+	} catch (const std::exception& e) {
+		RCLCPP_ERROR_STREAM(LOGGER, "Failed to plan request: " << e.what());
+		result.error_code = moveit::core::MoveItErrorCode::FAILURE;
+		return result;
+	}
+
+	for (const auto& solution : task.solutions()) {
+		if (solution->isFailure() || (max_solutions && result.solutions.size() >= max_solutions))
+			break;  // solutions are sorted by cost, failures come last
+		result.solutions.emplace_back();
+		solution->toMsg(result.solutions.back());
+	}
+	return result;
+}
+
+void TaskBatch::preempt() {
+	preempt_requested_ = true;
+	for (auto& worker : workers_)
+		worker->task.preempt();
+}
+}  // namespace task_constructor
+}  // namespace moveit
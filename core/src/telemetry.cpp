@@ -0,0 +1,130 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/task_constructor/telemetry.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace moveit {
+namespace task_constructor {
+
+void DurationHistogram::add(double duration) {
+	std::size_t bucket = 0;
+	if (duration >= MIN_DURATION)
+		bucket = std::min<std::size_t>(NUM_BUCKETS - 1, 1 + static_cast<std::size_t>(std::log2(duration / MIN_DURATION)));
+	++buckets_[bucket];
+	++count_;
+	sum_ += duration;
+	min_ = std::min(min_, duration);
+	max_ = std::max(max_, duration);
+}
+
+void DurationHistogram::clear() {
+	*this = DurationHistogram();
+}
+
+double DurationHistogram::upperBound(std::size_t i) {
+	if (i + 1 >= NUM_BUCKETS)
+		return std::numeric_limits<double>::infinity();
+	return std::ldexp(MIN_DURATION, static_cast<int>(i));
+}
+
+double DurationHistogram::quantile(double q) const {
+	if (count_ == 0)
+		return 0.0;
+	const double rank = std::clamp(q, 0.0, 1.0) * count_;
+	double accumulated = 0.0;
+	for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
+		if (buckets_[i] == 0 || accumulated + buckets_[i] < rank) {
+			accumulated += buckets_[i];
+			continue;
+		}
+		// interpolate within the bucket, restricted to the observed value range
+		const double lower = std::max(min_, i == 0 ? 0.0 : upperBound(i - 1));
+		const double upper = std::min(max_, upperBound(i));
+		return lower + (upper - lower) * (rank - accumulated) / buckets_[i];
+	}
+	return max_;
+}
+
+StageTelemetry::StageTelemetry(std::size_t max_samples) : max_samples_(max_samples) {
+	reset();
+}
+
+void StageTelemetry::reset() {
+	compute_times_.clear();
+	wait_times_.clear();
+	queue_depths_.clear();
+	max_queue_depth_ = 0;
+	num_solutions_ = 0;
+	epoch_ = clock::now();
+	first_start_ = last_stop_ = clock::time_point();
+}
+
+void StageTelemetry::recordCompute(clock::time_point start, clock::time_point stop, std::size_t queue_depth) {
+	if (compute_times_.count() == 0)
+		first_start_ = start;
+	last_stop_ = stop;
+	compute_times_.add(std::chrono::duration<double>(stop - start).count());
+
+	max_queue_depth_ = std::max(max_queue_depth_, queue_depth);
+	if (max_samples_ == 0)
+		return;
+	if (queue_depths_.size() >= max_samples_)
+		queue_depths_.pop_front();
+	queue_depths_.push_back({ std::chrono::duration<double>(start - epoch_).count(), queue_depth });
+}
+
+void StageTelemetry::recordWait(clock::time_point enqueued, clock::time_point dequeued) {
+	wait_times_.add(std::chrono::duration<double>(dequeued - enqueued).count());
+}
+
+void StageTelemetry::setMaxSamples(std::size_t max_samples) {
+	max_samples_ = max_samples;
+	while (queue_depths_.size() > max_samples_)
+		queue_depths_.pop_front();
+}
+
+double StageTelemetry::computeThroughput() const {
+	return compute_times_.sum() > 0.0 ? num_solutions_ / compute_times_.sum() : 0.0;
+}
+
+double StageTelemetry::throughput() const {
+	const double duration = std::chrono::duration<double>(last_stop_ - first_start_).count();
+	return duration > 0.0 ? num_solutions_ / duration : 0.0;
+}
+}  // namespace task_constructor
+}  // namespace moveit
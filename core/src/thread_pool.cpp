@@ -0,0 +1,124 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/task_constructor/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace moveit {
+namespace task_constructor {
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+	num_threads = std::max<std::size_t>(num_threads, 1);
+	workers_.reserve(num_threads);
+	for (std::size_t i = 0; i < num_threads; ++i)
+		workers_.emplace_back([this]() { run(); });
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	for (std::thread& worker : workers_)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(std::size_t n, const std::function<void(std::size_t)>& f) {
+	// shared with helper jobs, which might only start after this call returned
+	struct Shared
+	{
+		std::function<void(std::size_t)> f;
+		std::size_t n;
+		std::atomic<std::size_t> next{ 0 };
+		std::size_t done = 0;
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable cv;
+	};
+	auto shared = std::make_shared<Shared>();
+	shared->f = f;
+	shared->n = n;
+
+	auto work = [shared]() {
+		for (std::size_t i; (i = shared->next++) < shared->n;) {
+			std::exception_ptr error;
+			try {
+				shared->f(i);
+			} catch (...) {
+				error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> lock(shared->mutex);
+			if (error && !shared->error)
+				shared->error = error;
+			if (++shared->done == shared->n)
+				shared->cv.notify_all();
+		}
+	};
+
+	const std::size_t num_helpers = n > 1 ? std::min(n - 1, size()) : 0;
+	if (num_helpers > 0) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			for (std::size_t i = 0; i < num_helpers; ++i)
+				jobs_.emplace_back(work);
+		}
+		cv_.notify_all();
+	}
+	work();
+
+	std::unique_lock<std::mutex> lock(shared->mutex);
+	shared->cv.wait(lock, [&shared]() { return shared->done == shared->n; });
+	if (shared->error)
+		std::rethrow_exception(shared->error);
+}
+
+void ThreadPool::run() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+			if (jobs_.empty())  // stop_ requested and all jobs done
+				return;
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		job();  // exceptions are captured by the packaged_task
+	}
+}
+}  // namespace task_constructor
+}  // namespace moveit
@@ -1,8 +1,10 @@
 #include <moveit/task_constructor/container_p.h>
 #include <moveit/task_constructor/stage_p.h>
 #include <moveit/task_constructor/task_p.h>
+#include <moveit/task_constructor/thread_pool.h>
 #include <moveit/task_constructor/stages/fixed_state.h>
 #include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit_msgs/msg/attached_collision_object.hpp>
 
 #include "stage_mockups.h"
 #include "models.h"
@@ -10,7 +12,12 @@
 
 #include <gtest/gtest.h>
 #include <initializer_list>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory_resource>
+#include <mutex>
+#include <set>
 #include <thread>
 
 using namespace moveit::task_constructor;
@@ -629,6 +636,117 @@ TEST(Task, reuse) {
 	}
 }
 
+TEST(Task, arena) {
+	Task t;
+	t.setRobotModel(getModel());
+	auto fixed = std::make_unique<stages::FixedState>("fixed");
+	fixed->setState(std::make_shared<planning_scene::PlanningScene>(t.getRobotModel()));
+	t.add(std::move(fixed));
+
+	EXPECT_TRUE(t.plan());
+	ASSERT_EQ(t.solutions().size(), 1u);
+	std::weak_ptr<Arena> arena = t.arena();
+	EXPECT_GT(arena.lock()->allocatedBytes(), 0u);
+
+	// a solution kept by the user keeps its arena alive
+	SolutionBaseConstPtr solution = t.solutions().front();
+	t.reset();
+	EXPECT_FALSE(arena.expired());
+	EXPECT_NE(t.arena(), arena.lock());
+
+	// releasing the last reference frees the whole arena
+	solution.reset();
+	EXPECT_TRUE(arena.expired());
+	EXPECT_EQ(t.arena()->allocatedBytes(), 0u);
+}
+
+// memory resource counting (de)allocations forwarded to the heap
+struct CountingResource : public std::pmr::memory_resource
+{
+	std::atomic<std::size_t> allocations{ 0 };
+	std::atomic<std::size_t> deallocations{ 0 };
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		++deallocations;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(Arena, bulkRelease) {
+	CountingResource upstream;
+	{
+		auto arena = std::make_shared<Arena>(1024, &upstream);
+		std::vector<std::shared_ptr<int>> objects;
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		for (int t = 0; t < 4; ++t)
+			threads.emplace_back([&, t]() {
+				for (int i = 0; i < 100; ++i) {
+					auto object = std::allocate_shared<int>(ArenaAllocator<int>(arena), 100 * t + i);
+					std::lock_guard<std::mutex> lock(mutex);
+					objects.push_back(std::move(object));
+				}
+			});
+		for (auto& thread : threads)
+			thread.join();
+
+		// concurrently allocated objects don't overlap
+		std::set<int> values;
+		for (const auto& object : objects)
+			values.insert(*object);
+		EXPECT_EQ(values.size(), 400u);
+
+		// chunks are acquired from upstream, but not per allocation
+		EXPECT_GT(upstream.allocations, 1u);
+		EXPECT_LT(upstream.allocations, 400u);
+		EXPECT_EQ(upstream.allocations, arena->numChunks());
+		EXPECT_GT(arena->allocatedBytes(), 0u);
+
+		// destroying objects doesn't return any memory upstream
+		const std::size_t reserved = arena->reservedBytes();
+		objects.clear();
+		EXPECT_EQ(arena->allocatedBytes(), 0u);
+		EXPECT_EQ(arena->reservedBytes(), reserved);
+		EXPECT_EQ(upstream.deallocations, 0u);
+
+		// oversized requests get a dedicated chunk
+		auto large = std::allocate_shared<std::array<char, 4096>>(ArenaAllocator<std::array<char, 4096>>(arena));
+		EXPECT_GT(arena->reservedBytes(), reserved + 4096);
+	}
+	// ... but all chunks are released as a whole with the arena
+	EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(Arena, overflow) {
+	CountingResource upstream;
+	{
+		auto arena = std::make_shared<Arena>(1024, &upstream, 2048);
+		std::vector<std::shared_ptr<int>> objects;
+		for (int i = 0; i < 200; ++i)
+			objects.push_back(std::allocate_shared<int>(ArenaAllocator<int>(arena), i));
+
+		// the arena doesn't grow beyond its limit, but serves further requests from upstream
+		EXPECT_EQ(arena->numChunks(), 2u);
+		EXPECT_LE(arena->reservedBytes(), 2048u);
+		EXPECT_GT(arena->overflowBytes(), 0u);
+		EXPECT_GT(upstream.allocations, arena->numChunks());
+		for (int i = 0; i < 200; ++i)
+			EXPECT_EQ(*objects[i], i);
+
+		// ... which are returned there immediately
+		objects.clear();
+		EXPECT_EQ(arena->overflowBytes(), 0u);
+		EXPECT_EQ(arena->allocatedBytes(), 0u);
+		EXPECT_EQ(upstream.deallocations + arena->numChunks(), upstream.allocations);
+	}
+	EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
 // ForwardMockup that takes a while for its computation
 class TimedForwardMockup : public ForwardMockup
 {
@@ -673,6 +791,337 @@ TEST(Task, timeout) {
 	EXPECT_EQ(t.solutions().size(), 2u);
 }
 
+TEST_F(TaskTestBase, stop_at_cost_threshold) {
+	add(t, new GeneratorMockup(PredefinedCosts({ 5.0, 4.0, 3.0, 2.0, 1.0 })));
+	t.addStoppingCriterion(std::make_shared<CostThresholdCriterion>(3.0));
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 3u);
+	EXPECT_EQ(t.solutions().front()->cost(), 3.0);
+}
+
+TEST_F(TaskTestBase, stop_on_convergence) {
+	add(t, new GeneratorMockup(PredefinedCosts({ 5.0, 4.9, 4.8, 4.7, 1.0 })));
+	// improvements by less than 10% within 2 iterations are not significant
+	t.addStoppingCriterion(std::make_shared<ConvergenceCriterion>(0.1, std::numeric_limits<double>::infinity(), 2));
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 3u);
+
+	// criteria are reset when planning starts again
+	t.reset();
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 2u);  // generator continues with 4.7, 1.0
+}
+
+TEST_F(TaskTestBase, stop_on_convergence_near_zero) {
+	add(t, new GeneratorMockup(PredefinedCosts({ 1e-7, 5e-8, 2e-8, 1e-8, 0.0 })));
+	// relative improvements of costs close to zero are tiny in absolute terms
+	t.addStoppingCriterion(std::make_shared<ConvergenceCriterion>(0.1, std::numeric_limits<double>::infinity(), 2));
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 3u);
+}
+
+TEST_F(TaskTestBase, stop_on_lower_bound) {
+	add(t, new GeneratorMockup(PredefinedCosts({ 1.0, 10.0, 20.0 }), 3));
+	add(t, new ForwardMockup());
+
+	t.addStoppingCriterion(std::make_shared<LowerBoundCriterion>());
+	EXPECT_TRUE(t.plan());
+	// remaining partial solutions cannot beat the first one
+	EXPECT_EQ(t.solutions().size(), 1u);
+	EXPECT_EQ(t.pendingCostLowerBound(), 10.0);
+
+	t.clearStoppingCriteria();
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 3u);
+	EXPECT_EQ(t.pendingCostLowerBound(), std::numeric_limits<double>::infinity());
+}
+
+TEST_F(TaskTestBase, stop_on_lower_bound_active_generator) {
+	// the generator could compute more solutions (one per compute)
+	auto gen = add(t, new GeneratorMockup({ 1.0, 10.0, 20.0 }));
+	add(t, new ForwardMockup());
+	t.addStoppingCriterion(std::make_shared<LowerBoundCriterion>());
+
+	// a declared lower bound allows stopping while the generator is still active
+	gen->setCostLowerBound(5.0);
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 1u);
+	EXPECT_EQ(gen->runs_, 1u);
+	EXPECT_TRUE(gen->pimpl()->canCompute());
+	EXPECT_EQ(t.pendingCostLowerBound(), 5.0);
+
+	// without knowledge about its future solutions, an active generator bounds the cost to zero
+	gen->setCostLowerBound(0.0);
+	EXPECT_EQ(t.pendingCostLowerBound(), 0.0);
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 3u);
+}
+
+TEST_F(TaskTestBase, alternatives_link_states) {
+	add(t, new GeneratorMockup({ 1.0, 2.0 }));
+	auto alternatives = add(t, new Alternatives());
+	std::vector<ForwardMockup*> children;
+	for (int i = 0; i < 3; ++i)
+		children.push_back(add(*alternatives, new ForwardMockup()));
+	EXPECT_TRUE(t.plan());
+	ASSERT_EQ(alternatives->solutions().size(), 6u);
+
+	for (const SolutionBaseConstPtr& solution : alternatives->solutions()) {
+		// external start state was copied to all children: one internal state per child
+		const InterfaceState* external = solution->start();
+		std::set<const InterfaceState*> internals;
+		ContainerBasePrivate::forEachInternalState(external, [&](const InterfaceState* internal) {
+			EXPECT_EQ(ContainerBasePrivate::externalState(internal), external);
+			EXPECT_EQ(internal->outgoingTrajectories().size(), 1u);  // each child propagated its copy
+			internals.insert(internal);
+		});
+		EXPECT_EQ(internals.size(), 3u);
+
+		// lifted end state links to the end state of a single child solution
+		std::size_t num_internal_ends = 0;
+		ContainerBasePrivate::forEachInternalState(solution->end(), [&](const InterfaceState* internal) {
+			EXPECT_EQ(ContainerBasePrivate::externalState(internal), solution->end());
+			ASSERT_EQ(internal->incomingTrajectories().size(), 1u);
+			EXPECT_NE(internals.count(internal->incomingTrajectories().front()->start()), 0u);
+			++num_internal_ends;
+		});
+		EXPECT_EQ(num_internal_ends, 1u);
+	}
+	for (ForwardMockup* child : children)
+		EXPECT_EQ(child->solutions().size(), 2u);
+}
+
+TEST_F(TaskTestBase, replan_keeps_valid_solutions) {
+	auto gen = add(t, new GeneratorMockup(PredefinedCosts({ 1.0, 2.0 })));
+	auto fwd = add(t, new ForwardMockup());
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 2u);
+
+	// solutions remain valid in an unchanged scene, thus no recomputation is required
+	moveit_msgs::msg::PlanningScene diff;
+	diff.is_diff = true;
+	EXPECT_TRUE(t.replan(diff, 2));
+	EXPECT_EQ(t.solutions().size(), 2u);
+	EXPECT_EQ(gen->runs_, 2u);
+	EXPECT_EQ(fwd->runs_, 2u);
+}
+
+TEST_F(TaskTestBase, replan_resumes_fallbacks) {
+	auto gen = add(t, new GeneratorMockup(PredefinedCosts({ 1.0, 2.0, 3.0 })));
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	auto first = add(*fallbacks, new ForwardMockup());
+	auto second = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(10.0)));
+	t.add(std::move(fallbacks));
+	EXPECT_TRUE(t.plan(2));
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(1.0, 2.0));
+
+	// planning continues with the next job, not processing the current one again
+	moveit_msgs::msg::PlanningScene diff;
+	diff.is_diff = true;
+	EXPECT_TRUE(t.replan(diff));
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(1.0, 2.0, 3.0));
+	EXPECT_EQ(gen->runs_, 3u);
+	EXPECT_EQ(first->runs_, 3u);
+	EXPECT_EQ(second->runs_, 0u);
+}
+
+TEST_F(TaskTestBase, replan_resumes_connect) {
+	auto start = add(t, new GeneratorMockup(PredefinedCosts({ 1.0, 2.0 })));
+	auto connect = add(t, new ConnectMockup());
+	auto end = add(t, new GeneratorMockup(PredefinedCosts({ 10.0, 20.0 })));
+	EXPECT_TRUE(t.plan(2));
+	EXPECT_EQ(t.solutions().size(), 2u);
+	const std::size_t runs = connect->runs_;
+
+	// pending pairs are kept: only the remaining ones are connected
+	moveit_msgs::msg::PlanningScene diff;
+	diff.is_diff = true;
+	EXPECT_TRUE(t.replan(diff));
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(11.0, 12.0, 21.0, 22.0));
+	EXPECT_EQ(connect->runs_, runs + 2u);
+	EXPECT_EQ(start->runs_, 2u);
+	EXPECT_EQ(end->runs_, 2u);
+}
+
+// generator spawning states with a box attached to the robot at the given x positions (also used as costs)
+struct BoxGenerator : public GeneratorMockup
+{
+	BoxGenerator(std::initializer_list<double> positions)
+	  : GeneratorMockup(PredefinedCosts(std::list<double>(positions), true)) {}
+
+	// box of given size at position x
+	static moveit_msgs::msg::CollisionObject box(const std::string& id, double x, double size) {
+		moveit_msgs::msg::CollisionObject object;
+		object.id = id;
+		object.header.frame_id = "base";
+		object.pose.orientation.w = 1.0;
+		object.operation = moveit_msgs::msg::CollisionObject::ADD;
+		object.primitives.resize(1);
+		object.primitives[0].type = shape_msgs::msg::SolidPrimitive::BOX;
+		object.primitives[0].dimensions = { size, size, size };
+		object.primitive_poses.resize(1);
+		object.primitive_poses[0].position.x = x;
+		object.primitive_poses[0].orientation.w = 1.0;
+		return object;
+	}
+
+	void compute() override {
+		++runs_;
+		const double x = costs_.cost();
+
+		moveit_msgs::msg::AttachedCollisionObject box;
+		box.link_name = "base";
+		box.object = BoxGenerator::box("box", x, 0.1);
+
+		auto scene = ps_->diff();
+		scene->processAttachedCollisionObjectMsg(box);
+		spawn(InterfaceState(scene), x);
+	}
+};
+
+TEST_F(TaskTestBase, replan_drops_colliding_solutions) {
+	auto gen = add(t, new BoxGenerator({ 0.0, 1.0, 2.0, 3.0 }));
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	auto fwd = add(*fallbacks, new ForwardMockup());
+	auto fallback = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(10.0)));
+	t.add(std::move(fallbacks));
+	EXPECT_TRUE(t.plan(3));
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(0.0, 1.0, 2.0));
+
+	// add an obstacle colliding with the box of the second solution only
+	moveit_msgs::msg::PlanningScene diff;
+	diff.is_diff = true;
+	diff.world.collision_objects.push_back(BoxGenerator::box("obstacle", 1.0, 0.5));
+
+	EXPECT_EQ(t.revalidate(diff), 2u);
+	// affected solutions of all stages are dropped and marked as failures, unaffected ones are kept
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(0.0, 2.0));
+	EXPECT_COSTS(gen->solutions(), testing::ElementsAre(0.0, 2.0));
+	EXPECT_EQ(gen->numFailures(), 1u);
+	EXPECT_EQ(fwd->solutions().size(), 2u);
+	EXPECT_EQ(fwd->numFailures(), 1u);
+	// states of surviving solutions were updated with the diff
+	EXPECT_TRUE(t.solutions().front()->end()->scene()->getWorld()->hasObject("obstacle"));
+
+	// planning resumes without recomputing surviving solutions
+	EXPECT_TRUE(t.replan(diff, 3));
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(0.0, 2.0, 3.0));
+	EXPECT_EQ(gen->runs_, 4u);
+	EXPECT_EQ(fwd->runs_, 4u);
+	EXPECT_EQ(fallback->runs_, 0u);  // the invalidated job isn't passed on
+}
+
+TEST_F(TaskTestBase, revalidate_ignores_robot_state_of_diff) {
+	add(t, new BoxGenerator({ 0.0, 1.0, 2.0 }));
+	add(t, new ForwardMockup());
+	EXPECT_TRUE(t.plan());
+
+	// a diff from a monitor carries the monitored robot state, here with the box attached far away
+	moveit_msgs::msg::PlanningScene diff;
+	diff.is_diff = true;
+	diff.world.collision_objects.push_back(BoxGenerator::box("obstacle", 1.0, 0.5));
+	diff.robot_state.is_diff = false;
+	moveit_msgs::msg::AttachedCollisionObject attached;
+	attached.link_name = "base";
+	attached.object = BoxGenerator::box("box", 5.0, 0.1);
+	diff.robot_state.attached_collision_objects.push_back(attached);
+	moveit_msgs::msg::AttachedCollisionObject other = attached;
+	other.object = BoxGenerator::box("other", 5.0, 0.1);
+	diff.robot_state.attached_collision_objects.push_back(other);
+
+	// solutions are validated with their own robot states
+	EXPECT_EQ(t.revalidate(diff), 2u);
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(0.0, 2.0));
+
+	// ... which are kept in the updated scenes
+	for (const SolutionBaseConstPtr& solution : t.solutions()) {
+		const auto& scene = solution->end()->scene();
+		EXPECT_TRUE(scene->getWorld()->hasObject("obstacle"));
+		const moveit::core::RobotState& state = scene->getCurrentState();
+		EXPECT_EQ(state.getAttachedBody("other"), nullptr);
+		const moveit::core::AttachedBody* box = state.getAttachedBody("box");
+		ASSERT_NE(box, nullptr);
+		EXPECT_DOUBLE_EQ(box->getGlobalCollisionBodyTransforms()[0].translation().x(), solution->cost());
+	}
+}
+
+TEST_F(TaskTestBase, bounded_interface) {
+	// generator floods its successor with 5 states at once
+	auto gen = add(t, new GeneratorMockup(PredefinedCosts{ std::list<double>{ 5.0, 1.0, 4.0, 2.0, 3.0 }, true }, 5));
+	auto fwd = add(t, new ForwardMockup());
+	fwd->setInterfaceStorage(Interface::BOUNDED, 2);
+	EXPECT_EQ(fwd->interfaceStorage(), Interface::BOUNDED);
+
+	// only the 2 best states are kept and propagated
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(fwd->pimpl()->starts()->numDropped(), 3u);
+	ASSERT_EQ(t.solutions().size(), 2u);
+	EXPECT_EQ(t.solutions().front()->cost(), 1.0);
+	EXPECT_EQ(t.solutions().back()->cost(), 2.0);
+
+	// dropped states are pruned (together with the generator's start states), propagated ones remain enabled
+	std::size_t num_pruned = 0;
+	for (const SolutionBaseConstPtr& solution : gen->solutions()) {
+		const InterfaceState* state = solution->end();
+		EXPECT_EQ(state->owner(), nullptr);  // either consumed or dropped
+		if (state->outgoingTrajectories().empty()) {
+			EXPECT_EQ(state->priority().status(), InterfaceState::Status::PRUNED);
+			EXPECT_EQ(solution->start()->priority().status(), InterfaceState::Status::PRUNED);
+			++num_pruned;
+		} else
+			EXPECT_EQ(state->priority().status(), InterfaceState::Status::ENABLED);
+	}
+	EXPECT_EQ(num_pruned, 3u);
+}
+
+TEST_F(TaskTestBase, telemetry) {
+	auto gen1 = add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	auto con = add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 1.0, 2.0 }));
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 6u);
+
+	const StageTelemetry& telemetry = con->telemetry();
+	EXPECT_EQ(telemetry.numSolutions(), 6u);
+	EXPECT_EQ(telemetry.computeTimes().count(), 6u);  // one compute() per state pair
+	EXPECT_EQ(telemetry.waitTimes().count(), 6u);
+	EXPECT_EQ(telemetry.queueDepths().size(), 6u);
+	EXPECT_GE(telemetry.maxQueueDepth(), 1u);
+	EXPECT_GT(telemetry.computeThroughput(), 0.0);
+
+	EXPECT_EQ(gen1->telemetry().numSolutions(), 3u);
+	EXPECT_EQ(gen1->telemetry().waitTimes().count(), 0u);  // generators don't consume states
+	EXPECT_EQ(gen1->telemetry().maxQueueDepth(), 0u);
+
+	StageTelemetry cleared = telemetry;
+	cleared.reset();
+	EXPECT_EQ(cleared.computeTimes().count(), 0u);
+	EXPECT_EQ(cleared.numSolutions(), 0u);
+	EXPECT_TRUE(cleared.queueDepths().empty());
+}
+
+TEST(DurationHistogram, buckets) {
+	DurationHistogram h;
+	EXPECT_EQ(h.quantile(0.5), 0.0);
+	for (double d : { 1e-7, 1e-6, 1.5e-6, 1.0 })
+		h.add(d);
+
+	EXPECT_EQ(h.count(), 4u);
+	EXPECT_EQ(h.buckets()[0], 1u);
+	EXPECT_EQ(h.buckets()[1], 2u);
+	EXPECT_EQ(h.buckets()[20], 1u);  // 2^19 µs <= 1s < 2^20 µs
+	EXPECT_DOUBLE_EQ(h.min(), 1e-7);
+	EXPECT_DOUBLE_EQ(h.max(), 1.0);
+	EXPECT_DOUBLE_EQ(h.quantile(0.0), 1e-7);
+	EXPECT_DOUBLE_EQ(h.quantile(1.0), 1.0);
+	EXPECT_LT(h.quantile(0.5), DurationHistogram::upperBound(1));
+	EXPECT_EQ(DurationHistogram::upperBound(DurationHistogram::NUM_BUCKETS - 1),
+	          std::numeric_limits<double>::infinity());
+}
+
 // https://github.com/moveit/moveit_task_constructor/pull/597
 // https://github.com/moveit/moveit_task_constructor/pull/598
 // start planning in another thread, then preempt it in this thread
@@ -717,3 +1166,213 @@ TEST_F(TaskTestBase, preempt) {
 	EXPECT_EQ(fwd2->runs_, 0u);
 	EXPECT_TRUE(t.plan(1));  // make sure the preempt request has been resetted on the previous call to plan()
 }
+
+// GeneratorMockup waiting (with timeout) until the expected number of instances compute simultaneously
+class RendezvousGeneratorMockup : public GeneratorMockup
+{
+	std::atomic<unsigned int>& arrived_;
+	unsigned int expected_;
+
+public:
+	bool met_others_ = false;
+
+	RendezvousGeneratorMockup(std::atomic<unsigned int>& arrived, unsigned int expected)
+	  : GeneratorMockup{}, arrived_{ arrived }, expected_{ expected } {}
+	void compute() override {
+		++arrived_;
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (arrived_ < expected_ && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::yield();
+		met_others_ = arrived_ >= expected_;
+		GeneratorMockup::compute();
+	}
+};
+
+TEST_F(TaskTestBase, concurrent_compute) {
+	std::atomic<unsigned int> arrived{ 0 };
+	auto gen1 = add(t, new RendezvousGeneratorMockup(arrived, 3));
+	add(t, new ConnectMockup());
+	auto gen2 = add(t, new RendezvousGeneratorMockup(arrived, 3));
+	add(t, new ConnectMockup());
+	auto gen3 = add(t, new RendezvousGeneratorMockup(arrived, 3));
+
+	t.setNumThreads(3);
+	EXPECT_TRUE(t.plan());
+	EXPECT_EQ(t.solutions().size(), 1u);
+	EXPECT_TRUE(gen1->met_others_);
+	EXPECT_TRUE(gen2->met_others_);
+	EXPECT_TRUE(gen3->met_others_);
+}
+
+TEST(Task, concurrent_compute_is_deterministic) {
+	auto configure = [](Task& t) {
+		resetMockupIds();
+		t.setRobotModel(getModel());
+		t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 1.0, 2.0, 3.0 })));
+		t.add(std::make_unique<ForwardMockup>(PredefinedCosts({ 0.0, 10.0, 20.0 })));
+		t.add(std::make_unique<ConnectMockup>(PredefinedCosts({ 0.0, INF, 100.0, 0.0, 0.0, 200.0 })));
+
+		auto serial = std::make_unique<SerialContainer>();
+		serial->add(std::make_unique<BackwardMockup>(PredefinedCosts({ 0.0, 1000.0 })));
+		serial->add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 0.0, 0.5 })));
+		serial->add(std::make_unique<ForwardMockup>(PredefinedCosts::constant(0.0)));
+		t.add(std::move(serial));
+	};
+	auto plan = [&configure](size_t num_threads) {
+		Task t;
+		configure(t);
+		t.setNumThreads(num_threads);
+		EXPECT_TRUE(t.plan());
+		std::vector<std::pair<double, std::string>> result;
+		for (const auto& s : t.solutions())
+			result.emplace_back(s->cost(), s->comment());
+		return result;
+	};
+
+	auto sequential = plan(1);
+	EXPECT_GT(sequential.size(), 0u);
+	for (size_t num_threads : { 2, 4 })
+		EXPECT_EQ(plan(num_threads), sequential) << num_threads << " threads";
+}
+
+TEST(Task, scheduler_deepest_first) {
+	auto plan = [](const SchedulerPolicyConstPtr& policy, size_t max_solutions) {
+		resetMockupIds();
+		Task t;
+		t.setRobotModel(getModel());
+		t.add(std::make_unique<BackwardMockup>());
+		auto gen = new GeneratorMockup({ 1.0, 2.0, 3.0 });
+		t.add(Stage::pointer(gen));
+		t.add(std::make_unique<ForwardMockup>());
+		t.setSchedulerPolicy(policy);
+		EXPECT_TRUE(t.plan(max_solutions));
+		EXPECT_EQ(t.solutions().size(), max_solutions ? max_solutions : 3u);
+		return gen->runs_;
+	};
+
+	// by default, all children compute in each step: the generator computes again while finishing the first solution
+	EXPECT_EQ(plan(nullptr, 1), 2u);
+	// deepest-first completes existing partial solutions before generating new ones
+	EXPECT_EQ(plan(std::make_shared<DeepestFirstScheduler>(), 1), 1u);
+	// ... while finally finding all solutions
+	EXPECT_EQ(plan(std::make_shared<DeepestFirstScheduler>(), 0), 3u);
+}
+
+TEST(ThreadPool, parallelFor) {
+	ThreadPool pool(2);
+	std::vector<std::atomic<int>> counts(10);
+	// nested calls from within busy workers don't deadlock: callers process items themselves
+	pool.parallelFor(4, [&](std::size_t) { pool.parallelFor(counts.size(), [&](std::size_t i) { ++counts[i]; }); });
+	for (const auto& count : counts)
+		EXPECT_EQ(count, 4);
+
+	EXPECT_THROW(pool.parallelFor(3, [](std::size_t i) {
+		if (i == 1)
+			throw std::runtime_error("failure");
+	}),
+	             std::runtime_error);
+	pool.parallelFor(0, [](std::size_t) { ADD_FAILURE(); });
+}
+
+TEST(Scheduler, no_pending_state) {
+	GeneratorMockup gen;
+	ForwardMockup fw;
+	SchedulerPolicy::Candidates candidates{ gen, fw };
+	// a generator doesn't have pending states: it ranks behind any pending state, even expensive ones
+	EXPECT_GT(candidates[0].priority, InterfaceState::Priority(0u, 100.0));
+	candidates[1].priority = InterfaceState::Priority(0u, 100.0);
+
+	DeepestFirstScheduler().schedule(candidates);
+	ASSERT_EQ(candidates.size(), 1u);
+	EXPECT_EQ(candidates[0].stage, &fw);
+}
+
+TEST(Scheduler, cheapest_expected_cost) {
+	GeneratorMockup failing, slow, fast, untried;
+	SchedulerPolicy::Candidates candidates{ failing, slow, fast, untried };
+	auto set_stats = [](SchedulingCandidate& c, size_t solutions, size_t failures, double time) {
+		c.num_solutions = solutions;
+		c.num_failures = failures;
+		c.num_computes = solutions + failures;
+		c.compute_time = time;
+	};
+	set_stats(candidates[0], 0, 4, 1.0);
+	set_stats(candidates[1], 4, 0, 4.0);
+	set_stats(candidates[2], 4, 0, 1.0);
+
+	CheapestExpectedCostScheduler(2).schedule(candidates);
+	ASSERT_EQ(candidates.size(), 2u);
+	EXPECT_EQ(candidates[0].stage, &untried);
+	EXPECT_EQ(candidates[1].stage, &fast);
+
+	RoundRobinScheduler().schedule(candidates);
+	EXPECT_EQ(candidates.size(), 2u);
+}
+
+// ConnectMockup finishing its computations asynchronously, after being polled a few times
+struct AsyncConnectMockup : public ConnectMockup
+{
+	std::size_t max_in_flight_ = 0;
+	std::shared_ptr<unsigned int> cancelled_ = std::make_shared<unsigned int>(0);
+
+	void compute(const InterfaceState& from, const InterfaceState& to) override {
+		max_in_flight_ = std::max(max_in_flight_, numPendingRequests() + 1);
+		auto polls = std::make_shared<unsigned int>(3);
+		finishAsync([polls]() { return --*polls == 0; }, [polls]() { *polls = 0; },
+		            [this, &from, &to]() { ConnectMockup::compute(from, to); },
+		            [cancelled = cancelled_]() { ++*cancelled; });
+	}
+	void reset() override {
+		ConnectMockup::reset();
+		Connecting::reset();
+	}
+};
+
+TEST_F(TaskTestBase, async_requests) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	auto con = add(t, new AsyncConnectMockup());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	con->setMaxPendingRequests(2);
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(1.0, 2.0, 3.0));
+	EXPECT_EQ(con->max_in_flight_, 2u);
+	EXPECT_EQ(con->numPendingRequests(), 0u);
+}
+
+TEST_F(TaskTestBase, async_requests_cancelled_by_reset) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	auto con = add(t, new AsyncConnectMockup());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	con->setMaxPendingRequests(2);
+	EXPECT_TRUE(t.plan(1));
+	EXPECT_GT(con->numPendingRequests(), 0u);
+	t.reset();
+	EXPECT_EQ(con->numPendingRequests(), 0u);
+	EXPECT_GT(*con->cancelled_, 0u);
+}
+
+// ConnectMockup processing several pending pairs at once
+struct BatchConnectMockup : public ConnectMockup
+{
+	std::size_t max_batch_ = 0;
+
+	std::size_t batchSize() const override { return 3; }
+	void computeBatch(const StatePairs& pairs) override {
+		max_batch_ = std::max(max_batch_, pairs.size());
+		ConnectMockup::computeBatch(pairs);
+	}
+};
+
+TEST_F(TaskTestBase, connect_batch) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	auto con = add(t, new BatchConnectMockup());
+	add(t, new GeneratorMockup({ 10.0, 20.0 }));
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(11.0, 12.0, 13.0, 21.0, 22.0, 23.0));
+	EXPECT_GT(con->max_batch_, 1u);
+	EXPECT_LE(con->max_batch_, 3u);
+	EXPECT_EQ(con->runs_, 6u);
+}
@@ -123,6 +123,80 @@ TYPED_TEST(OrderedTest, sorting) {
 	this->validatePop();
 }
 
+TYPED_TEST(OrderedTest, indexedSorting) {
+	this->setIndexThreshold(0);
+	EXPECT_TRUE(this->indexed());
+
+	pushAndValidate(3, { 3 });
+	pushAndValidate(1, { 1, 3 });
+	pushAndValidate(4, { 1, 3, 4 });
+	pushAndValidate(2, { 1, 2, 3, 4 });
+	pushAndValidate(2, { 1, 2, 2, 3, 4 });
+	this->validatePop();
+}
+
+TEST(Ordered, indexedUpdate) {
+	const int n = 200;
+	std::vector<int> values(n);
+	ordered<int*> queue;
+	queue.setIndexThreshold(16);
+	for (int i = 0; i < n; ++i) {
+		values[i] = (i * 73) % n;  // insert values 0..n-1 in shuffled order
+		queue.insert(&values[i]);
+		EXPECT_EQ(queue.indexed(), queue.size() >= 16u);
+	}
+	EXPECT_TRUE(std::is_sorted(queue.begin(), queue.end(), ValueOrPointeeLess<int*>()));
+
+	// change values of some items, then update their position
+	std::vector<ordered<int*>::iterator> changed;
+	for (auto it = queue.begin(); it != queue.end(); ++it)
+		if (**it % 3 == 0) {
+			**it = 2 * n - **it;
+			changed.push_back(it);
+		}
+	for (auto& it : changed)
+		queue.update(it);
+	EXPECT_TRUE(std::is_sorted(queue.begin(), queue.end(), ValueOrPointeeLess<int*>()));
+
+	queue.remove_if([](int* value) { return *value % 2 == 0; });
+	EXPECT_EQ(queue.size(), static_cast<std::size_t>(n / 2));
+	int last = -1;
+	while (!queue.empty()) {
+		int value = *queue.pop();
+		EXPECT_EQ(value % 2, 1);
+		EXPECT_LT(last, value);
+		last = value;
+	}
+	EXPECT_TRUE(queue.indexed());  // the index is kept until clear()
+	queue.clear();
+	EXPECT_FALSE(queue.indexed());
+}
+
+TEST(Ordered, indexedMove) {
+	ordered<int> queue;
+	queue.setIndexThreshold(0);
+	for (int value : { 3, 1, 2 })
+		queue.insert(value);
+
+	ordered<int> moved(std::move(queue));
+	EXPECT_TRUE(moved.indexed());
+	EXPECT_FALSE(queue.indexed());  // NOLINT(bugprone-use-after-move): moved-from queue is empty and usable
+	EXPECT_TRUE(queue.empty());
+	queue.insert(4);  // with its index threshold of 0, the moved-from queue builds a new index
+	EXPECT_TRUE(queue.indexed());
+	EXPECT_EQ(queue.size(), 1u);
+
+	ordered<int> assigned;
+	assigned = std::move(moved);
+	EXPECT_TRUE(assigned.indexed());
+	EXPECT_FALSE(moved.indexed());  // NOLINT(bugprone-use-after-move)
+	EXPECT_TRUE(moved.empty());
+	moved.insert(5);
+	assigned.insert(0);
+	EXPECT_EQ(std::vector<int>(assigned.begin(), assigned.end()), std::vector<int>({ 0, 1, 2, 3 }));
+	EXPECT_EQ(std::vector<int>(moved.begin(), moved.end()), std::vector<int>({ 5 }));
+}
+
 template <typename ValueType, typename CostType>
 std::ostream& operator<<(std::ostream& os, const cost_ordered<ValueType, CostType>& queue) {
 	for (const auto& pair : queue.sorted())
@@ -177,3 +251,15 @@ TEST_F(CostOrderedTestInt, update) {
 	EXPECT_EQ(queue.top(), first);
 	EXPECT_EQ(*(++queue.begin()), added);
 }
+
+TEST_F(CostOrderedTestInt, indexedInsertBehindEqualCosts) {
+	queue.setIndexThreshold(0);
+	insert(1, 3);
+	insert(2, 3);
+	insert(3, 3);
+	insert(4, 2);
+	std::vector<int> values;
+	for (const auto& item : queue)
+		values.push_back(item.value());
+	EXPECT_THAT(values, ::testing::ElementsAre(4, 1, 2, 3));
+}
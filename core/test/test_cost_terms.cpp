@@ -159,11 +159,9 @@ TEST(CostTerm, SolutionConnected) {
 
 		using TrajectoryCostTerm::operator();
 		double operator()(const SubTrajectory& s, std::string& /*comment*/) const override {
-			EXPECT_EQ(&*container_.state_start,
-			          const_cast<const SerialContainerPrivate*>(container_.pimpl())->internalToExternalMap().at(s.start()))
+			EXPECT_EQ(&*container_.state_start, ContainerBasePrivate::externalState(s.start()))
 			    << "SubTrajectory is not connected to its expected start InterfaceState";
-			EXPECT_EQ(&*container_.state_end,
-			          const_cast<const SerialContainerPrivate*>(container_.pimpl())->internalToExternalMap().at(s.end()))
+			EXPECT_EQ(&*container_.state_end, ContainerBasePrivate::externalState(s.end()))
 			    << "SubTrajectory is not connected to its expected end InterfaceState";
 			EXPECT_EQ(s.creator(), creator_);
 			return TERM_COST;
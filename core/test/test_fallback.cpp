@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <initializer_list>
+#include <list>
 #include <chrono>
 #include <thread>
 
@@ -83,6 +84,100 @@ TEST_F(FallbacksFixturePropagate, computeFirstSuccessfulStagePerSolutionOnly) {
 	EXPECT_COSTS(t.solutions(), testing::ElementsAre(113, 124, 212, 221));
 }
 
+TEST_F(FallbacksFixturePropagate, speculativeChildren) {
+	t.setNumThreads(3);
+	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 1.0, 2.0 })));
+
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	fallbacks->setSpeculativeChildren(2);
+	auto first = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(INF)));
+	auto second = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(10.0)));
+	auto third = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(20.0)));
+	t.add(std::move(fallbacks));
+
+	EXPECT_TRUE(t.plan());
+	// all children computed each job, but results of the third one were discarded
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(11, 12));
+	EXPECT_EQ(first->runs_, 2u);
+	EXPECT_EQ(second->runs_, 2u);
+	EXPECT_EQ(third->runs_, 2u);
+}
+
+TEST_F(FallbacksFixturePropagate, speculativeChildrenDiscardJobCopies) {
+	t.setNumThreads(2);
+	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 1.0, 2.0 })));
+
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	fallbacks->setSpeculativeChildren(1);
+	auto first = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(10.0)));
+	// the wrapper keeps the job copies in its interface
+	auto inner = new ForwardMockup(PredefinedCosts::constant(20.0));
+	auto speculative = add(*fallbacks, new DelayingWrapper({}, Stage::pointer(inner)));
+	t.add(std::move(fallbacks));
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(11, 12));
+	EXPECT_EQ(first->runs_, 2u);
+	EXPECT_EQ(inner->runs_, 2u);  // computed speculatively, but results were discarded
+	EXPECT_TRUE(speculative->solutions().empty());
+
+	// the speculative copies of both jobs are pruned and not linked to the jobs anymore
+	const auto& starts = *speculative->pimpl()->starts();
+	ASSERT_EQ(starts.size(), 2u);
+	for (const InterfaceState* state : starts) {
+		EXPECT_EQ(state->priority().status(), InterfaceState::Status::PRUNED);
+		EXPECT_EQ(ContainerBasePrivate::externalState(state), nullptr);
+		// which is propagated to the wrapped child
+		ContainerBasePrivate::forEachInternalState(state, [](const InterfaceState* internal) {
+			EXPECT_EQ(internal->priority().status(), InterfaceState::Status::PRUNED);
+		});
+	}
+	// thus, the speculative child won't compute them again
+	EXPECT_FALSE(speculative->pimpl()->canCompute());
+}
+
+// wrapper processing its child's solutions only in its own compute(), like ComputeIK
+struct BufferingWrapper : public WrapperBase
+{
+	std::list<const SolutionBase*> pending_;
+
+	BufferingWrapper(Stage::pointer&& child) : WrapperBase("buffering", std::move(child)) {}
+
+	void reset() override {
+		pending_.clear();
+		WrapperBase::reset();
+	}
+	bool canCompute() const override { return !pending_.empty() || WrapperBase::canCompute(); }
+	void compute() override {
+		if (WrapperBase::canCompute())
+			WrapperBase::compute();
+		if (pending_.empty())
+			return;
+		liftSolution(*pending_.front());
+		pending_.pop_front();
+	}
+	void onNewSolution(const SolutionBase& s) override { pending_.push_back(&s); }
+};
+
+TEST_F(FallbacksFixturePropagate, speculativeChildrenWithWrapper) {
+	t.setNumThreads(2);
+	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 1.0, 2.0 })));
+
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	fallbacks->setSpeculativeChildren(1);
+	auto inner = new ForwardMockup();
+	auto wrapper = add(*fallbacks, new BufferingWrapper(Stage::pointer(inner)));
+	auto second = add(*fallbacks, new ForwardMockup(PredefinedCosts::constant(10.0)));
+	t.add(std::move(fallbacks));
+
+	// the wrapper's solutions, only lifted after replaying the child's results, count for the job
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), testing::ElementsAre(1, 2));
+	EXPECT_EQ(inner->runs_, 2u);
+	EXPECT_EQ(wrapper->solutions().size(), 2u);
+	EXPECT_TRUE(second->solutions().empty());
+}
+
 // requires individual job control in Fallbacks's children
 TEST_F(FallbacksFixturePropagate, DISABLED_updateSolutionOrder) {
 	t.add(std::make_unique<BackwardMockup>(PredefinedCosts({ 10.0, 0.0 })));
@@ -197,6 +292,37 @@ TEST_F(FallbacksFixtureConnect, connectStageInsideFallbacks) {
 	EXPECT_COSTS(t.solutions(), testing::ElementsAre(11, 12, 22, 121));
 }
 
+TEST_F(FallbacksFixtureConnect, subsequentChildRanksUpdatedPairs) {
+	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 1.0, 2.0 }), 2));
+
+	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
+	auto first = add(*fallbacks, new ConnectMockup(PredefinedCosts::constant(INF)));
+	auto second = add(*fallbacks, new ConnectMockup());
+	t.add(std::move(fallbacks));
+
+	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 10.0 })));
+
+	// let the first child fail both pairs, passing them to the second child
+	t.init();
+	StagePrivate* stages = t.stages()->pimpl();
+	while (stages->canCompute() && second->pimpl()->queueDepth() < 2)
+		stages->runCompute();
+	ASSERT_EQ(second->pimpl()->queueDepth(), 2u);
+	ASSERT_EQ(first->pimpl()->queueDepth(), 0u);
+
+	// improve the priority of the initially worse pair
+	const InterfaceState* start = nullptr;
+	for (const InterfaceState* state : *first->pimpl()->starts())
+		if (state->priority().cost() == 2.0)
+			start = state;
+	ASSERT_NE(start, nullptr);
+	const InterfaceState* end = first->pimpl()->ends()->front();
+	const_cast<InterfaceState*>(start)->updatePriority(InterfaceState::Priority(start->priority().depth(), 0.0));
+
+	// the second child ranks that pair first now
+	EXPECT_EQ(second->pimpl()->pendingPriority(), start->priority() + end->priority());
+}
+
 TEST_F(FallbacksFixtureConnect, connectInsideSerialInsideFallbacks) {
 	t.add(std::make_unique<GeneratorMockup>(PredefinedCosts({ 0.0 })));
 	auto fallbacks = std::make_unique<Fallbacks>("Fallbacks");
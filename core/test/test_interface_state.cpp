@@ -6,6 +6,7 @@
 #include <memory>
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <vector>
 #include <gtest/gtest.h>
 #include <gmock/gmock-matchers.h>
@@ -72,6 +73,87 @@ TEST(Interface, update) {
 	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 3, 6 }));
 }
 
+TEST(Interface, find) {
+	auto ps = std::make_shared<planning_scene::PlanningScene>(getModel());
+	StoringInterface i;
+	for (unsigned int depth = 1; depth <= 100; ++depth)
+		i.add(InterfaceState(ps, Prio(depth, 0.0)));
+	std::vector<InterfaceState*> states(i.begin(), i.end());
+
+	// states keep track of their position within the interface, also while being reordered
+	for (std::size_t k = 0; k < states.size(); k += 3)
+		i.updatePriority(states[k], Prio(states[k]->priority().depth(), 1.0, InterfaceState::Status::ARMED));
+	for (InterfaceState* state : states) {
+		EXPECT_EQ(&*i.find(state), state);
+		EXPECT_EQ(&*static_cast<const Interface&>(i).find(state), state);
+	}
+	i.remove(i.find(states[1]));
+	EXPECT_EQ(states[1]->owner(), nullptr);
+	EXPECT_EQ(i.size(), states.size() - 1);
+}
+
+TEST(Interface, fifo) {
+	auto ps = std::make_shared<planning_scene::PlanningScene>(getModel());
+	StoringInterface i(Interface::NotifyFunction(), Interface::FIFO);
+	i.add(InterfaceState(ps, Prio(1, 0.0)));
+	i.add(InterfaceState(ps, Prio(3, 0.0)));
+	i.add(InterfaceState(ps, Prio(2, 0.0)));
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 1, 3, 2 }));
+
+	// priority updates don't reorder, but disabled states move behind enabled ones
+	i.updatePriority(*i.rbegin(), Prio(5, 0.0));
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 1, 3, 5 }));
+	i.updatePriority(*i.begin(), Prio(1, 0.0, InterfaceState::Status::ARMED));
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 3, 5, 1 }));
+
+	// switching to sorted storage resorts existing states
+	i.setStorage(Interface::SORTED);
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 5, 3, 1 }));
+}
+
+TEST(Interface, bounded) {
+	auto ps = std::make_shared<planning_scene::PlanningScene>(getModel());
+	EXPECT_THROW(Interface(Interface::NotifyFunction(), Interface::BOUNDED), std::runtime_error);
+	EXPECT_THROW(Interface([](Interface::iterator, Interface::UpdateFlags) {}, Interface::BOUNDED, 2),
+	             std::runtime_error);
+
+	StoringInterface i(Interface::NotifyFunction(), Interface::BOUNDED, 2);
+	i.add(InterfaceState(ps, Prio(1, 0.0)));
+	i.add(InterfaceState(ps, Prio(3, 0.0)));
+	i.add(InterfaceState(ps, Prio(2, 0.0)));  // drops lowest-priority state 1
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 3, 2 }));
+	i.add(InterfaceState(ps, Prio(1, 0.0)));  // dropped immediately
+	EXPECT_THAT(i.depths(), ::testing::ElementsAreArray({ 3, 2 }));
+	EXPECT_EQ(i.numDropped(), 2u);
+
+	i.clear();
+	EXPECT_EQ(i.numDropped(), 0u);
+}
+
+TEST(Interface, lowestEnabledCost) {
+	auto ps = std::make_shared<planning_scene::PlanningScene>(getModel());
+	StoringInterface i;
+	EXPECT_EQ(i.lowestEnabledCost(), std::numeric_limits<double>::infinity());
+	i.add(InterfaceState(ps, Prio(1, 2.0)));
+	i.add(InterfaceState(ps, Prio(3, 5.0)));  // sorted first due to larger depth
+	EXPECT_EQ(i.lowestEnabledCost(), 2.0);
+
+	// the cached value follows additions and priority updates
+	i.add(InterfaceState(ps, Prio(1, 1.0)));
+	EXPECT_EQ(i.lowestEnabledCost(), 1.0);
+	InterfaceState* cheapest = *std::next(i.begin());
+	ASSERT_EQ(cheapest->priority().cost(), 1.0);
+	i.updatePriority(cheapest, Prio(1, 1.0, InterfaceState::Status::ARMED));
+	EXPECT_EQ(i.lowestEnabledCost(), 2.0);
+	i.updatePriority(cheapest, Prio(1, 0.5));
+	EXPECT_EQ(i.lowestEnabledCost(), 0.5);
+
+	i.remove(i.find(cheapest));
+	EXPECT_EQ(i.lowestEnabledCost(), 2.0);
+	i.clear();
+	EXPECT_EQ(i.lowestEnabledCost(), std::numeric_limits<double>::infinity());
+}
+
 using PrioPair = std::pair<Prio, Prio>;
 inline bool operator<(const PrioPair& lhs, const PrioPair& rhs) {
 	return ConnectingPrivate::StatePair::less(lhs.first, lhs.second, rhs.first, rhs.second);
@@ -95,3 +177,49 @@ TEST(StatePairs, compare) {
 		EXPECT_TRUE(good_good < pair(bad, bad));
 	}
 }
+
+TEST(StatePairs, pending) {
+	auto ps = std::make_shared<planning_scene::PlanningScene>(getModel());
+	StoringInterface starts, ends;
+	for (double cost : { 1.0, 2.0 }) {
+		starts.add(InterfaceState(ps, Prio(1, cost)));
+		ends.add(InterfaceState(ps, Prio(1, 10 * cost)));
+	}
+	Interface::iterator s1 = starts.begin(), s2 = std::next(s1);
+	Interface::iterator e1 = ends.begin(), e2 = std::next(e1);
+
+	using Pair = ConnectingPrivate::StatePair;
+	ConnectingPrivate::PendingPairs pending;
+	for (auto s : { s1, s2 })
+		for (auto e : { e1, e2 })
+			pending.insert(Pair(s, e));
+	EXPECT_EQ(pending.size(), 4u);
+	EXPECT_EQ(pending.pairsOf(&*s1).size(), 2u);
+	EXPECT_EQ(pending.top(), Pair(s1, e1));
+
+	// changing a state's priority re-ranks all its pairs
+	starts.updatePriority(&*s1, Prio(1, 100.0));
+	pending.update(&*s1);
+	EXPECT_EQ(pending.top(), Pair(s2, e1));
+	EXPECT_THAT(pending.sorted(), ::testing::ElementsAre(Pair(s2, e1), Pair(s2, e2), Pair(s1, e1), Pair(s1, e2)));
+
+	// unnoticed priority changes are detected when reaching the top
+	ends.updatePriority(&*e1, Prio(1, 0.0, InterfaceState::Status::ARMED));
+	EXPECT_EQ(pending.pop(), Pair(s2, e2));
+	EXPECT_EQ(pending.pop(), Pair(s1, e2));
+	EXPECT_EQ(pending.pairsOf(&*e2).size(), 0u);
+	EXPECT_EQ(pending.size(), 2u);
+
+	// nodes of popped pairs are reused, without reviving their outdated entries
+	pending.insert(Pair(s2, e2));
+	for (int i = 0; i < 100; ++i)
+		pending.update(&*s2);
+	EXPECT_THAT(pending.sorted(), ::testing::ElementsAre(Pair(s2, e2), Pair(s2, e1), Pair(s1, e1)));
+	EXPECT_EQ(pending.pop(), Pair(s2, e2));
+	EXPECT_EQ(pending.pop(), Pair(s2, e1));
+	EXPECT_EQ(pending.size(), 1u);
+
+	pending.clear();
+	EXPECT_TRUE(pending.empty());
+	EXPECT_TRUE(pending.pairsOf(&*s1).empty());
+}
@@ -0,0 +1,189 @@
+#include <moveit/task_constructor/container_p.h>
+#include <moveit/task_constructor/introspection.h>
+#include <moveit/task_constructor/task.h>
+
+#include "stage_mockups.h"
+
+#include <rclcpp/rclcpp.hpp>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace moveit::task_constructor;
+using moveit_task_constructor_msgs::msg::StageStatistics;
+using moveit_task_constructor_msgs::msg::TaskStatistics;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+struct IncrementalStatistics : TaskTestBase
+{
+	GeneratorMockup* gen;
+	TaskStatistics msg;
+
+	IncrementalStatistics() {
+		gen = add(t, new GeneratorMockup({ 1, 2, 3, 4 }));
+		t.enableIntrospection();
+		t.introspection().setIncrementalStatistics(true, 3);
+		t.init();
+	}
+
+	// fill next statistics message, returning the statistics of gen (nullptr if not listed)
+	const StageStatistics* next() {
+		t.introspection().fillTaskState(msg);
+		const uint32_t id = t.introspection().stageId(gen);
+		for (const auto& s : msg.stages)
+			if (s.id == id)
+				return &s;
+		return nullptr;
+	}
+
+	// compute a new solution of gen, returning its id
+	uint32_t compute() {
+		const size_t num_solutions = gen->solutions().size();
+		t.compute();
+		EXPECT_EQ(gen->solutions().size(), num_solutions + 1);
+		return t.introspection().solutionId(*gen->solutions().back());
+	}
+
+	// move solution with given id from solved to failed
+	void invalidate(uint32_t id) {
+		const size_t num_failures = gen->failures().size();
+		t.stages()->pimpl()->invalidateSolutions(
+		    [this, id](const SolutionBase& s) { return t.introspection().solutionId(s) == id; }, "invalid");
+		EXPECT_EQ(gen->failures().size(), num_failures + 1);
+	}
+};
+
+TEST_F(IncrementalStatistics, deltas) {
+	// start with a full snapshot
+	const StageStatistics* s = next();
+	EXPECT_FALSE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, IsEmpty());
+
+	// unchanged stages are not listed
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	EXPECT_THAT(msg.stages, IsEmpty());
+
+	// only new solutions are listed
+	const uint32_t first = compute();
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, ElementsAre(first));
+	EXPECT_THAT(s->solved_costs, ElementsAre(1.0));
+	EXPECT_THAT(s->failed, IsEmpty());
+
+	// every 3rd message is a full snapshot again
+	const uint32_t second = compute();
+	const uint32_t third = compute();
+	s = next();
+	EXPECT_FALSE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, ElementsAre(first, second, third));
+	EXPECT_THAT(s->solved_costs, ElementsAre(1.0, 2.0, 3.0));
+
+	// deltas refer to the previous full snapshot
+	next();
+	EXPECT_TRUE(msg.incremental);
+	EXPECT_THAT(msg.stages, IsEmpty());
+}
+
+TEST_F(IncrementalStatistics, solvedToFailed) {
+	next();  // initial full snapshot
+	const uint32_t first = compute();
+	const uint32_t second = compute();
+	next();
+
+	// a solution moved from solved to failed is listed as new failure
+	invalidate(second);
+	const StageStatistics* s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, IsEmpty());
+	EXPECT_THAT(s->failed, ElementsAre(second));
+	EXPECT_EQ(s->num_failed, 1u);
+
+	// full snapshots list all failures
+	const uint32_t third = compute();
+	invalidate(third);
+	s = next();
+	EXPECT_FALSE(msg.incremental);  // every 3rd message
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, ElementsAre(first));
+	EXPECT_THAT(s->failed, ElementsAre(second, third));
+	EXPECT_EQ(s->num_failed, 2u);
+
+	// a solution solved and failed since the previous message is only listed as failure
+	const uint32_t fourth = compute();
+	invalidate(fourth);
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, IsEmpty());
+	EXPECT_THAT(s->failed, ElementsAre(fourth));
+	EXPECT_EQ(s->num_failed, 3u);
+}
+
+TEST_F(IncrementalStatistics, telemetryOnlyIfChanged) {
+	t.introspection().setPublishTelemetry(true);
+	const StageStatistics* s = next();  // full snapshot
+	ASSERT_NE(s, nullptr);
+	EXPECT_EQ(s->telemetry.size(), 1u);
+
+	const uint32_t first = compute();
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	ASSERT_EQ(s->telemetry.size(), 1u);
+	EXPECT_EQ(s->telemetry.front().queue_depth.size(), 1u);
+
+	// invalidating a solution doesn't change telemetry
+	invalidate(first);
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->failed, ElementsAre(first));
+	EXPECT_THAT(s->telemetry, IsEmpty());
+
+	// full snapshots always include telemetry
+	s = next();
+	EXPECT_FALSE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_EQ(s->telemetry.size(), 1u);
+}
+
+TEST_F(IncrementalStatistics, discardedAfterSnapshot) {
+	const uint32_t first = compute();
+	const uint32_t second = compute();
+	const StageStatistics* s = next();  // full snapshot
+	EXPECT_FALSE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, ElementsAre(first, second));
+
+	// a solution already reported as solved needs to be reported as discarded again
+	invalidate(first);
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, IsEmpty());
+	EXPECT_THAT(s->failed, ElementsAre(first));
+
+	// ... but only once
+	s = next();
+	EXPECT_TRUE(msg.incremental);
+	EXPECT_EQ(s, nullptr);
+
+	// the next full snapshot doesn't list it as solved anymore
+	s = next();
+	EXPECT_FALSE(msg.incremental);
+	ASSERT_NE(s, nullptr);
+	EXPECT_THAT(s->solved, ElementsAre(second));
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	rclcpp::init(argc, argv);
+
+	return RUN_ALL_TESTS();
+}
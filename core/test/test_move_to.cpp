@@ -5,6 +5,8 @@
 #include <moveit/task_constructor/stages/move_to.h>
 #include <moveit/task_constructor/stages/connect.h>
 #include <moveit/task_constructor/stages/fixed_state.h>
+#include <moveit/task_constructor/stages/compute_ik.h>
+#include <moveit/task_constructor/stages/generate_pose.h>
 #include <moveit/task_constructor/solvers/joint_interpolation.h>
 #include <moveit/task_constructor/solvers/cartesian_path.h>
 
@@ -13,6 +15,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 
 #include <moveit_msgs/msg/robot_state.hpp>
+#include <moveit_msgs/msg/constraints.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 
 #include <rclcpp/logging.hpp>
@@ -180,6 +183,95 @@ TEST(Panda, connectCartesianBranchesFails) {
 	             "Trajectory end-point deviates too much from goal state");
 }
 
+// search IK solutions for the "ready" pose of panda_link8
+struct PandaComputeIK : public testing::Test
+{
+	Task t;
+	stages::ComputeIK* ik;
+
+	PandaComputeIK() {
+		t.loadRobotModel(rclcpp::Node::make_shared("panda_compute_ik"));
+		auto scene = std::make_shared<PlanningScene>(t.getRobotModel());
+		scene->getCurrentStateNonConst().setToDefaultValues();
+		auto fixed = std::make_unique<stages::FixedState>("start", scene);
+		auto gen = std::make_unique<stages::GeneratePose>("pose");
+		gen->setMonitoredStage(fixed.get());
+		gen->setPose(getFramePoseOfNamedState(scene->getCurrentState(), "ready", "panda_link8"));
+		t.add(std::move(fixed));
+
+		auto compute_ik = std::make_unique<stages::ComputeIK>("ik", std::move(gen));
+		ik = compute_ik.get();
+		ik->setGroup("panda_arm");
+		ik->setIKFrame("panda_link8");
+		ik->setMaxIKSolutions(4);
+		ik->setMinSolutionDistance(0.5);
+		ik->setTimeout(2.0);
+		ik->properties().configureInitFrom(Stage::INTERFACE, { "target_pose" });
+
+		stages::Connect::GroupPlannerVector planner = {
+			{ "panda_arm", std::make_shared<solvers::JointInterpolationPlanner>() }
+		};
+		t.add(std::make_unique<stages::Connect>("connect", planner));
+		t.add(std::move(compute_ik));
+	}
+
+	// all solutions (successful and failed) spawned by the ComputeIK stage
+	std::vector<const SolutionBase*> ikResults() const {
+		std::vector<const SolutionBase*> result(ik->solutions().begin(), ik->solutions().end());
+		result.insert(result.end(), ik->failures().begin(), ik->failures().end());
+		return result;
+	}
+
+	void expectDistinct(const std::vector<const SolutionBase*>& solutions, double min_distance) const {
+		auto jmg = t.getRobotModel()->getJointModelGroup("panda_arm");
+		for (size_t i = 0; i < solutions.size(); ++i)
+			for (size_t j = i + 1; j < solutions.size(); ++j)
+				EXPECT_GE(solutions[i]->end()->scene()->getCurrentState().distance(
+				              solutions[j]->end()->scene()->getCurrentState(), jmg),
+				          min_distance)
+				    << "duplicate IK solutions " << i << " and " << j;
+	}
+};
+
+TEST_F(PandaComputeIK, multiThreadedSearch) {
+	auto plan = [this](uint32_t num_ik_threads) {
+		t.reset();
+		t.setNumThreads(num_ik_threads);
+		ik->setNumIKThreads(num_ik_threads);
+		t.plan();  // connecting might fail, only IK solutions are of interest
+		auto results = ikResults();
+		EXPECT_GT(ik->solutions().size(), 0u) << num_ik_threads << " threads";
+		EXPECT_LE(results.size(), 4u) << "max_ik_solutions exceeded with " << num_ik_threads << " threads";
+		expectDistinct(results, 0.5);
+	};
+	plan(1);
+	plan(4);
+}
+
+TEST_F(PandaComputeIK, multiThreadedRejectedSolutions) {
+	// no IK solution satisfies the constraint: all of them are rejected, but still reported as failures
+	moveit_msgs::msg::Constraints constraints;
+	constraints.joint_constraints.resize(1);
+	auto& jc = constraints.joint_constraints.front();
+	jc.joint_name = "panda_joint4";
+	jc.position = 0.0;  // panda_joint4 is limited to [-3.07, -0.07]
+	jc.tolerance_above = jc.tolerance_below = 0.01;
+	jc.weight = 1.0;
+	ik->setProperty("constraints", constraints);
+	ik->setTimeout(0.5);
+
+	t.setNumThreads(4);
+	ik->setNumIKThreads(4);
+	EXPECT_FALSE(t.plan());
+	EXPECT_EQ(ik->solutions().size(), 0u);
+	auto results = ikResults();
+	ASSERT_GT(results.size(), 0u);
+	EXPECT_LE(results.size(), 4u);
+	expectDistinct(results, 0.5);
+	for (const SolutionBase* s : results)
+		EXPECT_TRUE(s->isFailure());
+}
+
 // This test requires a running rosmaster
 TEST(Task, taskMoveConstructor) {
 	auto create_task = [] {
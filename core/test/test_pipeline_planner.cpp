@@ -4,6 +4,13 @@
 #include <moveit/robot_model/robot_model.hpp>
 
 #include <moveit/task_constructor/solvers/pipeline_planner.h>
+#include <moveit/task_constructor/stages/move_to.h>
+#include <moveit/task_constructor/task_batch.h>
+#include <moveit/task_constructor/thread_pool.h>
+#include <moveit/planning_scene/planning_scene.hpp>
+
+#include <future>
+#include <mutex>
 
 using namespace moveit::task_constructor;
 
@@ -46,6 +53,22 @@ TEST_F(PipelinePlannerTest, testValidPlan) {
 	EXPECT_EQ(pipeline_planner.getPlannerId(), "stomp");
 }
 
+TEST_F(PipelinePlannerTest, testValidPlanAsync) {
+	// GIVEN an initialized PipelinePlanner, owned by a shared_ptr
+	auto pipeline_planner = std::make_shared<solvers::PipelinePlanner>(node, "STOMP", "stomp");
+	pipeline_planner->init(robot_model);
+	// WHEN a solution for a valid request is requested asynchronously on a thread pool
+	ThreadPool pool(1);
+	auto scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+	auto future = pipeline_planner->planAsync(&pool, scene, scene, robot_model->getJointModelGroup("group"), 1.0);
+	// THEN the future eventually provides a successful result
+	ASSERT_TRUE(future.valid());
+	const auto& result = future.get();
+	EXPECT_TRUE(result.result);
+	EXPECT_TRUE(result.trajectory);
+	EXPECT_FALSE(future.cancelled());
+}
+
 TEST_F(PipelinePlannerTest, testInvalidPipelineID) {
 	// GIVEN a valid initialized PipelinePlanner instance
 	auto pipeline_planner = solvers::PipelinePlanner(node, "STOMP", "stomp");
@@ -55,6 +78,91 @@ TEST_F(PipelinePlannerTest, testInvalidPipelineID) {
 	EXPECT_FALSE(pipeline_planner.setPlannerId("CHOMP", "stomp"));
 }
 
+TEST_F(PipelinePlannerTest, testClonesSharePipelines) {
+	// GIVEN a PipelinePlanner and its clone
+	auto prototype = std::make_shared<solvers::PipelinePlanner>(node, "STOMP", "stomp");
+	auto clone = std::dynamic_pointer_cast<solvers::PipelinePlanner>(prototype->clone());
+	ASSERT_TRUE(clone);
+	// WHEN the clone is initialized first, THEN the original planner reuses its pipelines
+	clone->init(robot_model);
+	prototype->init(robot_model);
+	ASSERT_EQ(prototype->planningPipelines().size(), 1u);
+	EXPECT_EQ(clone->planningPipelines(), prototype->planningPipelines());
+	// while properties are configured independently
+	clone->setProperty("goal_joint_tolerance", 1e-3);
+	EXPECT_EQ(prototype->properties().get<double>("goal_joint_tolerance"), 1e-4);
+}
+
+TEST_F(PipelinePlannerTest, testConcurrentClones) {
+	// GIVEN two initialized clones sharing the same pipeline
+	auto prototype = std::make_shared<solvers::PipelinePlanner>(node, "STOMP", "stomp");
+	auto clone = prototype->clone();
+	prototype->init(robot_model);
+	clone->init(robot_model);
+	// WHEN both plan concurrently
+	auto scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+	const auto* group = robot_model->getJointModelGroup("group");
+	auto plan = [&](const solvers::PlannerInterfacePtr& planner) {
+		auto result = std::make_shared<robot_trajectory::RobotTrajectory>(robot_model, group);
+		return bool(planner->plan(scene, scene, group, 1.0, result));
+	};
+	auto other = std::async(std::launch::async, plan, clone);
+	// THEN both requests succeed on the shared pipeline
+	EXPECT_TRUE(plan(prototype));
+	EXPECT_TRUE(other.get());
+}
+
+TEST_F(PipelinePlannerTest, testCloneWithAdditionalPipeline) {
+	node->declare_parameter<std::vector<std::string>>("STOMP2.planning_plugins", { "stomp_moveit/StompPlanner" });
+	// GIVEN an initialized PipelinePlanner and a clone configured with an additional pipeline
+	auto prototype = std::make_shared<solvers::PipelinePlanner>(node, "STOMP", "stomp");
+	prototype->init(robot_model);
+	auto clone = std::dynamic_pointer_cast<solvers::PipelinePlanner>(prototype->clone());
+	clone->setProperty("pipeline_id_planner_id_map",
+	                   std::unordered_map<std::string, std::string>{ { "STOMP", "stomp" }, { "STOMP2", "stomp" } });
+	// WHEN the clone is initialized
+	clone->init(robot_model);
+	// THEN it creates the additional pipeline, reusing the existing one
+	ASSERT_EQ(clone->planningPipelines().size(), 2u);
+	EXPECT_EQ(clone->planningPipelines().at("STOMP"), prototype->planningPipelines().at("STOMP"));
+	EXPECT_NE(clone->planningPipelines().at("STOMP2"), nullptr);
+}
+
+TEST_F(PipelinePlannerTest, testTaskBatchSharesPipelines) {
+	// GIVEN a prototype PipelinePlanner, whose clones are used by the workers of a TaskBatch
+	auto prototype = std::make_shared<solvers::PipelinePlanner>(node, "STOMP", "stomp");
+	std::map<std::string, double> goal;
+	for (const std::string& name : robot_model->getJointModelGroup("group")->getActiveJointModelNames())
+		goal[name] = 0.1;
+	std::mutex mutex;
+	std::vector<solvers::PipelinePlannerPtr> clones;
+	TaskBatch batch(
+	    robot_model,
+	    [&](Task& t) {
+		    auto clone = std::dynamic_pointer_cast<solvers::PipelinePlanner>(prototype->clone());
+		    {
+			    std::lock_guard<std::mutex> lock(mutex);
+			    clones.push_back(clone);
+		    }
+		    auto move_to = std::make_unique<stages::MoveTo>("move to", clone);
+		    move_to->setGroup("group");
+		    move_to->setGoal(goal);
+		    t.add(std::move(move_to));
+	    },
+	    2);
+	ASSERT_EQ(clones.size(), 2u);
+
+	// WHEN planning several requests concurrently
+	auto scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+	scene->getCurrentStateNonConst().setToDefaultValues();
+	auto results = batch.plan(std::vector<TaskBatch::Request>(4, TaskBatch::Request{ scene, {} }));
+	// THEN all requests succeed and all workers use the same (single) set of pipelines
+	for (const auto& result : results)
+		EXPECT_EQ(result.error_code, moveit::core::MoveItErrorCode::SUCCESS);
+	ASSERT_FALSE(clones[0]->planningPipelines().empty());
+	EXPECT_EQ(clones[0]->planningPipelines(), clones[1]->planningPipelines());
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	rclcpp::init(argc, argv);
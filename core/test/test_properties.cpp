@@ -1,4 +1,5 @@
 #include <moveit/task_constructor/properties.h>
+#include <geometry_msgs/msg/pose.hpp>
 
 #include <gtest/gtest.h>
 #include <initializer_list>
@@ -76,6 +77,111 @@ TEST(Property, reset) {
 	EXPECT_EQ(props.get<double>("double1"), 1.0);
 }
 
+TEST(Property, handle) {
+	PropertyMap props;
+	props.declare<double>("double1");
+
+	EXPECT_THROW(props.handle<double>("double2"), Property::undeclared);
+	EXPECT_THROW(props.handle<int>("double1"), Property::type_error);
+
+	PropertyHandle<double> h = props.handle<double>("double1");
+	ASSERT_TRUE(h.valid());
+	EXPECT_EQ(h.name(), "double1");
+	EXPECT_THROW(h.get(), Property::undefined);
+	EXPECT_EQ(h.get(0.0), 0.0);
+
+	// handle tracks value changes
+	props.set("double1", 1.0);
+	EXPECT_EQ(h.get(), 1.0);
+	props.setCurrent("double1", 2.0);
+	EXPECT_EQ(h.get(), 2.0);
+	props.reset();
+	EXPECT_EQ(h.get(), 1.0);
+
+	// properties declared as boost::any yield the any itself
+	props.declare<boost::any>("any");
+	PropertyHandle<boost::any> a = props.handle<boost::any>("any");
+	EXPECT_THROW(a.get(), Property::undefined);
+	props.set("any", 3);
+	EXPECT_EQ(boost::any_cast<int>(a.get()), 3);
+	EXPECT_EQ(boost::any_cast<int>(a.get(boost::any(0))), 3);
+}
+
+TEST(Property, copyOnWrite) {
+	PropertyMap props;
+	props.declare<double>("double1", 1.0);
+	props.declare<double>("double2");
+
+	PropertyMap copy(props);
+	const PropertyMap& const_props = props;
+	const PropertyMap& const_copy = copy;
+	EXPECT_EQ(&const_copy.property("double1"), &const_props.property("double1"));  // storage is shared
+	copy.set("double1", 2.0);  // ... until modified
+	EXPECT_NE(&const_copy.property("double1"), &const_props.property("double1"));
+	EXPECT_EQ(props.get<double>("double1"), 1.0);
+	EXPECT_EQ(copy.get<double>("double1"), 2.0);
+
+	// setFrom() shares the value
+	PropertyMap other;
+	other.setFrom("double1", copy.property("double1"));
+	other.setFrom("double2", copy.property("double1"));
+	EXPECT_EQ(&other.get("double1"), &copy.get("double1"));
+	EXPECT_EQ(other.get<double>("double2"), 2.0);
+	EXPECT_THROW(other.setFrom("double3", props.property("double2")), Property::undeclared);
+
+	// modifications don't affect the sharing map
+	boost::any_cast<double&>(other.property("double1").value()) = 3.0;
+	EXPECT_EQ(other.get<double>("double1"), 3.0);
+	EXPECT_EQ(copy.get<double>("double1"), 2.0);
+
+	// maps with handles don't share their storage
+	PropertyHandle<double> h = copy.handle<double>("double1");
+	PropertyMap pinned(copy);
+	pinned.set("double1", 4.0);
+	copy.set("double1", 5.0);
+	EXPECT_EQ(h.get(), 5.0);
+	EXPECT_EQ(pinned.get<double>("double1"), 4.0);
+
+	// references into a map aren't shared with later copies either
+	Property& p = props.property("double2");
+	PropertyMap later(props);
+	p.setValue(6.0);
+	EXPECT_EQ(props.get<double>("double2"), 6.0);
+	EXPECT_TRUE(later.get("double2").empty());
+}
+
+TEST(Property, assignPinned) {
+	PropertyMap props;
+	props.declare<double>("double1", 1.0);
+	props.declare<int>("int");
+	PropertyHandle<double> h = props.handle<double>("double1");
+
+	PropertyMap other;
+	other.declare<double>("double1", 2.0);
+	other.declare<std::string>("int");  // redeclared with another type
+	other.declare<double>("double2", 3.0);
+
+	// handles remain valid and see the assigned values
+	props = other;
+	EXPECT_EQ(h.get(), 2.0);
+	EXPECT_EQ(props.property("int").typeName(), other.property("int").typeName());
+	EXPECT_EQ(props.get<double>("double2"), 3.0);
+
+	// ... but the storage isn't shared with the source
+	other.set("double1", 4.0);
+	EXPECT_EQ(h.get(), 2.0);
+	props.set("double1", 5.0);
+	EXPECT_EQ(h.get(), 5.0);
+	EXPECT_EQ(other.get<double>("double1"), 4.0);
+
+	// same for move assignment
+	PropertyMap moved;
+	moved.declare<double>("double1", 6.0);
+	props = std::move(moved);
+	EXPECT_EQ(h.get(), 6.0);
+	EXPECT_FALSE(props.hasProperty("double2"));
+}
+
 TEST(Property, anytype) {
 	PropertyMap props;
 	props.declare<boost::any>("any", "store any type");
@@ -107,6 +213,44 @@ TEST(Property, serialize) {
 	EXPECT_EQ(props.property("map").serialize(), "");
 }
 
+TEST(Property, serializeBinary) {
+	PropertyMap props;
+	props.declare<double>("double", 3.14);
+	props.set("string", "foo");
+	props.declare<geometry_msgs::msg::Pose>("pose");
+
+	// arithmetic types are transmitted as text only
+	std::string text;
+	std::vector<uint8_t> binary;
+	props.property("double").serialize(text, binary, true);
+	EXPECT_EQ(text, "3.14");
+	EXPECT_TRUE(binary.empty());
+	EXPECT_EQ(boost::any_cast<double>(Property::deserialize(props.property("double").typeName(), text)), 3.14);
+
+	// other types without binary serialization only as text, too
+	props.property("string").serialize(text, binary);
+	EXPECT_EQ(text, "foo");
+	EXPECT_TRUE(binary.empty());
+
+	// ROS messages as text and in binary form
+	props.property("pose").serialize(text, binary);
+	EXPECT_TRUE(text.empty() && binary.empty());  // undefined
+	geometry_msgs::msg::Pose pose;
+	pose.position.x = 1.0;
+	pose.orientation.w = 1.0;
+	props.set("pose", pose);
+	props.property("pose").serialize(text, binary);
+	EXPECT_EQ(text, props.property("pose").serialize());
+	ASSERT_FALSE(binary.empty());
+	boost::any value = Property::deserializeBinary(props.property("pose").typeName(), binary);
+	EXPECT_EQ(boost::any_cast<geometry_msgs::msg::Pose>(value), pose);
+
+	// binary-only is opt-in
+	props.property("pose").serialize(text, binary, true);
+	EXPECT_TRUE(text.empty());
+	EXPECT_FALSE(binary.empty());
+}
+
 class InitFromTest : public ::testing::Test
 {
 protected:
@@ -174,3 +318,39 @@ TEST_F(InitFromTest, function) {
 	slave.performInitFrom(1, master);
 	EXPECT_EQ(slave.get<double>("double3"), 3.0);
 }
+
+TEST_F(InitFromTest, incremental) {
+	unsigned int calls = 0;
+	slave.property("double3").configureInitFrom(1, [&calls](const PropertyMap& other) -> boost::any {
+		++calls;
+		return other.get<double>("double1");
+	});
+	slave.property("double1").configureInitFrom(1, "double1");
+	slave.performInitFrom(1, master);
+	EXPECT_EQ(calls, 1u);
+	EXPECT_EQ(slave.get<double>("double3"), 1.0);
+
+	// unchanged source: skipped entirely
+	const uint64_t version = slave.version();
+	slave.performInitFrom(1, master);
+	EXPECT_EQ(calls, 1u);
+	EXPECT_EQ(slave.version(), version);
+
+	// modified source: re-evaluate
+	master.set("double1", 5.0);
+	slave.performInitFrom(1, master);
+	EXPECT_EQ(calls, 2u);
+	EXPECT_EQ(slave.get<double>("double1"), 5.0);
+	EXPECT_EQ(slave.get<double>("double3"), 5.0);
+
+	// copied source map: re-evaluate too, yielding identical values
+	PropertyMap copy(master);
+	slave.performInitFrom(1, copy);
+	EXPECT_EQ(calls, 3u);
+	EXPECT_EQ(slave.get<double>("double1"), 5.0);
+
+	// manually overridden values are kept
+	slave.set("double1", 0.0);
+	slave.performInitFrom(1, copy);
+	EXPECT_EQ(slave.get<double>("double1"), 0.0);
+}
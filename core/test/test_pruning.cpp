@@ -1,8 +1,10 @@
 #include <moveit/task_constructor/task.h>
+#include <moveit/task_constructor/stage_p.h>
 
 #include "stage_mockups.h"
 #include "models.h"
 
+#include <functional>
 #include <list>
 #include <memory>
 
@@ -24,6 +26,87 @@ TEST_F(Pruning, PropagatorFailure) {
 	EXPECT_EQ(back->runs_, 0u);
 }
 
+TEST_F(Pruning, CollectPrunedBranches) {
+	add(t, new BackwardMockup());
+	auto gen = add(t, new GeneratorMockup({ 0 }));
+	add(t, new ForwardMockup({ INF }));
+
+	t.setCollectPrunedBranches(true);
+	EXPECT_FALSE(t.plan());
+	ASSERT_EQ(gen->solutions().size(), 1u);
+	const SolutionBase& s = *gen->solutions().front();
+	ASSERT_EQ(s.start()->priority().status(), InterfaceState::Status::PRUNED);
+
+	// the pruned generator branch cannot be re-enabled: its scenes are released, while its solution is kept
+	EXPECT_EQ(s.start()->scene(), nullptr);
+	EXPECT_EQ(s.end()->scene(), nullptr);
+	EXPECT_EQ(gen->solutions().size(), 1u);
+	// nothing left to collect
+	EXPECT_EQ(t.collectPrunedBranches(), 0u);
+}
+
+TEST_F(Pruning, CollectPrunedBranchesOnlyIfEnabled) {
+	add(t, new BackwardMockup());
+	auto gen = add(t, new GeneratorMockup({ 0 }));
+	add(t, new ForwardMockup({ INF }));
+
+	// without collection enabled, pruned states are not recorded
+	EXPECT_FALSE(t.plan());
+	ASSERT_EQ(gen->solutions().size(), 1u);
+	const SolutionBase& s = *gen->solutions().front();
+	ASSERT_EQ(s.start()->priority().status(), InterfaceState::Status::PRUNED);
+	EXPECT_EQ(t.collectPrunedBranches(), 0u);
+	EXPECT_NE(s.start()->scene(), nullptr);
+}
+
+TEST_F(Pruning, KeepArmedBranches) {
+	add(t, new BackwardMockup);
+	auto gen = add(t, new GeneratorMockup({ 0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ INF }));
+
+	// the ARMED generator branch might be re-enabled by new states in the Connect stage
+	t.setCollectPrunedBranches(true);
+	EXPECT_FALSE(t.plan());
+	ASSERT_EQ(gen->solutions().size(), 1u);
+	EXPECT_NE(gen->solutions().front()->start()->scene(), nullptr);
+}
+
+// calls hook before computing a state
+struct HookedForward : ForwardMockup
+{
+	std::function<void(const InterfaceState&)> hook;
+	using ForwardMockup::ForwardMockup;
+	void computeForward(const InterfaceState& from) override {
+		hook(from);
+		ForwardMockup::computeForward(from);
+	}
+};
+
+TEST_F(Pruning, KeepBranchesOfFetchedStates) {
+	add(t, new GeneratorMockup({ 0 }));
+	add(t, new ForwardMockup(PredefinedCosts::constant(0.0), 2));
+	auto fwd = add(t, new HookedForward({ INF, 0 }));
+
+	// collect while the second state is computed: being fetched, it isn't owned by an interface anymore
+	bool collected = false;
+	fwd->hook = [&](const InterfaceState& from) {
+		if (fwd->runs_ != 1)
+			return;
+		EXPECT_EQ(from.owner(), nullptr);
+		t.collectPrunedBranches();
+		EXPECT_NE(from.scene(), nullptr);
+		collected = true;
+	};
+	t.setCollectPrunedBranches(true);
+	t.init();
+	StagePrivate* stages = t.stages()->pimpl();
+	while (stages->canCompute())
+		stages->runCompute();
+	EXPECT_TRUE(collected);
+	EXPECT_EQ(t.solutions().size(), 1u);
+}
+
 // Same as the previous test, except pruning is disabled for the whole task
 TEST_F(Pruning, DisabledPruningPropagatorFailure) {
 	t.setPruning(false);
@@ -1,4 +1,5 @@
 #include <moveit/task_constructor/task.h>
+#include <moveit/task_constructor/container_p.h>
 #include <moveit/task_constructor/stages.h>
 #include <moveit/task_constructor/cost_terms.h>
 #include <moveit/task_constructor/solvers/joint_interpolation.h>
@@ -7,8 +8,10 @@
 
 #include "stage_mockups.h"
 #include "models.h"
+#include <limits>
 #include <list>
 #include <memory>
+#include <vector>
 
 using namespace moveit::task_constructor;
 using namespace planning_scene;
@@ -58,6 +61,94 @@ TEST_F(ConnectConnect, SuccSucc) {
 	EXPECT_COSTS(t.solutions(), ::testing::ElementsAre(11, 12, 13, 21, 22, 23));
 }
 
+TEST_F(ConnectConnect, ConcurrentPairs) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	auto con1 = add(t, new Connect());
+	add(t, new GeneratorMockup({ 10.0, 20.0 }));
+	auto con2 = add(t, new Connect());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	// planning several pairs at once yields the same solutions
+	con1->setMaxConcurrentPairs(4);
+	con2->setMaxConcurrentPairs(2);
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), ::testing::ElementsAre(11, 12, 13, 21, 22, 23));
+}
+
+TEST_F(ConnectConnect, IncrementalAssembly) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 10.0, 20.0 }));
+	add(t, new ForwardMockup(PredefinedCosts::constant(100.0)));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	// assembling solutions from incrementally updated path priorities yields the same solutions
+	t.stages()->setProperty("incremental_assembly", true);
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), ::testing::ElementsAre(111, 112, 113, 121, 122, 123));
+}
+
+using LazyEnumeration = TestBase;
+TEST_F(LazyEnumeration, LiftsRequestedSolutionsOnly) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 10.0, 20.0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	t.stages()->setProperty("lazy_enumeration", true);
+	std::vector<double> lifted;
+	t.stages()->addSolutionCallback([&lifted](const SolutionBase& s) {
+		EXPECT_NE(dynamic_cast<const SolutionSequence*>(&s), nullptr);
+		lifted.push_back(s.cost());
+	});
+	EXPECT_TRUE(t.plan(2));
+	// the cheapest solutions are lifted first, in increasing cost order
+	EXPECT_THAT(lifted, ::testing::ElementsAre(11, 12));
+	// only those were materialized as SolutionSequences
+	EXPECT_EQ(t.stages()->solutions().size(), 2u);
+	EXPECT_COSTS(t.stages()->solutions(), ::testing::ElementsAre(11, 12));
+}
+
+TEST_F(LazyEnumeration, EnumeratesAllSolutions) {
+	add(t, new GeneratorMockup({ 1.0, 2.0, 3.0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 10.0, 20.0 }));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 0.0 }));
+
+	t.stages()->setProperty("lazy_enumeration", true);
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), ::testing::ElementsAre(11, 12, 13, 21, 22, 23));
+}
+
+TEST_F(LazyEnumeration, CandidatesBoundPendingCost) {
+	add(t, new GeneratorMockup(PredefinedCosts({ 1.0, 2.0 }), 2));
+	add(t, new ConnectMockup());
+	add(t, new GeneratorMockup({ 10.0 }));
+
+	t.stages()->setProperty("lazy_enumeration", true);
+	t.init();
+	// compute all children, but don't lift any full solution yet
+	bool computed = true;
+	while (computed) {
+		computed = false;
+		for (const auto& child : t.stages()->pimpl()->children())
+			if (child->pimpl()->canCompute()) {
+				child->pimpl()->runCompute();
+				computed = true;
+			}
+	}
+	EXPECT_TRUE(t.solutions().empty());
+	// the unlifted full solutions are still pending
+	EXPECT_EQ(t.pendingCostLowerBound(), 11.0);
+
+	EXPECT_TRUE(t.plan());
+	EXPECT_COSTS(t.solutions(), ::testing::ElementsAre(11, 12));
+	EXPECT_EQ(t.pendingCostLowerBound(), std::numeric_limits<double>::infinity());
+}
+
 // https://github.com/moveit/moveit_task_constructor/issues/218
 TEST_F(ConnectConnect, FailSucc) {
 	add(t, new GeneratorMockup());
@@ -6,6 +6,7 @@
 #include <moveit/planning_scene/planning_scene.hpp>
 
 #include <gtest/gtest.h>
+#include <iterator>
 
 using namespace moveit::task_constructor;
 using namespace planning_scene;
@@ -32,3 +33,36 @@ TEST(SolutionMsg, DuplicateScenes) {
 	EXPECT_EQ(solution_msg.start_scene.is_diff, false);
 	EXPECT_EQ(solution_msg.sub_trajectory.front().scene_diff.is_diff, true);
 }
+
+TEST(SolutionSequence, SharedSegments) {
+	SubTrajectory a, b, c, d;
+	auto prefix = std::make_shared<const SolutionSequence::container_type>(SolutionSequence::container_type{ &a, &b });
+	SolutionSequence first(SolutionSequence::Segments{ prefix, nullptr,
+	                                                   std::make_shared<const SolutionSequence::container_type>(
+	                                                       SolutionSequence::container_type{ &c }) });
+	SolutionSequence second(SolutionSequence::Segments{ prefix });
+
+	// sequences share their prefix, but iterate over all of their sub solutions
+	EXPECT_EQ(first.solutions().size(), 3u);
+	EXPECT_EQ(std::vector<const SolutionBase*>(first.solutions().begin(), first.solutions().end()),
+	          (std::vector<const SolutionBase*>{ &a, &b, &c }));
+	EXPECT_EQ(first.solutions()[2], &c);
+	EXPECT_EQ(second.solutions().back(), &b);
+
+	// appending to a sequence doesn't modify shared segments
+	second.push_back(d);
+	EXPECT_EQ(second.solutions().size(), 3u);
+	EXPECT_EQ(second.solutions()[2], &d);
+	EXPECT_EQ(prefix->size(), 2u);
+	EXPECT_EQ(first.solutions()[2], &c);
+
+	// copies don't share the extendable tail segment
+	SolutionSequence copy(second);
+	second.push_back(a);
+	copy.push_back(b);
+	EXPECT_EQ(second.solutions().size(), 4u);
+	EXPECT_EQ(second.solutions().back(), &a);
+	EXPECT_EQ(copy.solutions().size(), 4u);
+	EXPECT_EQ(copy.solutions().back(), &b);
+	EXPECT_EQ(std::distance(copy.solutions().begin(), copy.solutions().end()), 4);
+}
@@ -0,0 +1,69 @@
+#include <moveit/task_constructor/task_batch.h>
+#include <moveit/planning_scene/planning_scene.hpp>
+
+#include "stage_mockups.h"
+#include "models.h"
+
+#include <gtest/gtest.h>
+
+using namespace moveit::task_constructor;
+
+// forward stage using the (inherited) property "cost" as cost of its solutions
+struct PropertyCostForward : public PropagatingForward
+{
+	PropertyCostForward() : PropagatingForward("property cost") {
+		properties().declare<double>("cost", "cost of solutions");
+		properties().configureInitFrom(Stage::PARENT, { "cost" });
+	}
+	void computeForward(const InterfaceState& from) override {
+		SubTrajectory solution{ robot_trajectory::RobotTrajectoryConstPtr(), properties().get<double>("cost") };
+		sendForward(from, InterfaceState{ from.scene()->diff() }, std::move(solution));
+	}
+};
+
+TEST(TaskBatch, plan) {
+	auto robot_model = getModel();
+	TaskBatch batch(
+	    robot_model,
+	    [](Task& t) {
+		    t.setProperty("cost", 1.0);
+		    t.add(std::make_unique<PropertyCostForward>());
+	    },
+	    3);
+	ASSERT_EQ(batch.numWorkers(), 3u);
+
+	auto scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+	std::vector<TaskBatch::Request> requests(10, TaskBatch::Request{ scene, {} });
+	// override cost for every second request only
+	for (size_t i = 0; i < requests.size(); i += 2)
+		requests[i].properties["cost"] = 2.0 + i;
+
+	auto results = batch.plan(requests);
+	ASSERT_EQ(results.size(), requests.size());
+	for (size_t i = 0; i < results.size(); ++i) {
+		EXPECT_EQ(results[i].error_code, moveit::core::MoveItErrorCode::SUCCESS) << i;
+		ASSERT_EQ(results[i].solutions.size(), 1u) << i;
+		ASSERT_FALSE(results[i].solutions[0].sub_trajectory.empty());
+		// overridden properties are restored for subsequent requests
+		EXPECT_EQ(results[i].solutions[0].sub_trajectory.back().info.cost, i % 2 ? 1.0 : 2.0 + i) << i;
+	}
+
+	// tasks are reused for further batches
+	results = batch.plan({ TaskBatch::Request{ scene, {} } });
+	ASSERT_EQ(results.size(), 1u);
+	EXPECT_EQ(results[0].error_code, moveit::core::MoveItErrorCode::SUCCESS);
+}
+
+TEST(TaskBatch, failingRequest) {
+	auto robot_model = getModel();
+	TaskBatch batch(robot_model, [](Task& t) { t.add(std::make_unique<ForwardMockup>(PredefinedCosts::constant(INF))); },
+	                2);
+
+	auto scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+	auto results = batch.plan({ TaskBatch::Request{ scene, {} }, TaskBatch::Request{ scene, {} } });
+	ASSERT_EQ(results.size(), 2u);
+	for (const auto& result : results) {
+		EXPECT_EQ(result.error_code, moveit::core::MoveItErrorCode::PLANNING_FAILED);
+		EXPECT_TRUE(result.solutions.empty());
+	}
+}
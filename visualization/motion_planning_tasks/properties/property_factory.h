@@ -41,6 +41,7 @@
 #include <map>
 #include <functional>
 #include <typeindex>
+#include <vector>
 
 #include <moveit/task_constructor/properties.h>
 
@@ -105,6 +106,13 @@ public:
 	static rviz_common::properties::Property* createDefault(const std::string& name, const std::string& type,
 	                                                        const std::string& description, const std::string& value,
 	                                                        rviz_common::properties::Property* old = nullptr);
+	/// create rviz_common::properties::Property for property of given name, type, description, and binary value
+	static rviz_common::properties::Property* createDefault(const std::string& name, const std::string& type,
+	                                                        const std::string& description,
+	                                                        const std::vector<uint8_t>& binary,
+	                                                        rviz_common::properties::Property* old = nullptr);
+	/// convert a CDR-serialized ROS message of given type into YAML, returns false if it cannot be decoded
+	static bool messageToYaml(const std::string& type, const std::vector<uint8_t>& binary, std::string& yaml);
 
 	/// create PropertyTreeModel for given Stage
 	rviz_common::properties::PropertyTreeModel* createPropertyTreeModel(moveit::task_constructor::Stage& stage,
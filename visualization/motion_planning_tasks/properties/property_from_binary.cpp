@@ -0,0 +1,267 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Bielefeld University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include "property_factory.h"
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/typesupport_helpers.hpp>
+#include <rcpputils/shared_library.hpp>
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+#include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
+
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+
+/** Implement PropertyFactory::createDefault() for binary-serialized values of types unknown to rviz.
+ *  ROS messages are decoded from CDR via rosidl introspection.
+ *  The decoded value is converted into YAML and processed like a text-serialized value.
+ */
+
+namespace ts = ::rosidl_typesupport_introspection_cpp;
+
+namespace {
+
+// type support of a ROS message type, loaded dynamically by name
+struct MessageType
+{
+	// libraries need to stay loaded while their type supports are used
+	std::shared_ptr<rcpputils::SharedLibrary> library_;
+	std::shared_ptr<rcpputils::SharedLibrary> introspection_library_;
+	const rosidl_message_type_support_t* type_support_ = nullptr;
+	const ts::MessageMembers* members_ = nullptr;
+};
+
+// convert MTC's type name (e.g. geometry_msgs::msg::Pose) to ROS' type name (geometry_msgs/msg/Pose)
+std::string rosTypeName(const std::string& type) {
+	std::string result;
+	for (size_t pos = 0; pos < type.size(); ++pos) {
+		if (type.compare(pos, 2, "::") == 0) {
+			result.push_back('/');
+			++pos;
+		} else
+			result.push_back(type[pos]);
+	}
+	return result;
+}
+
+// return type support for given message type, nullptr if unavailable
+const MessageType* messageType(const std::string& type) {
+	static std::map<std::string, std::unique_ptr<MessageType>> cache;
+	auto it = cache.find(type);
+	if (it != cache.end())
+		return it->second.get();
+
+	auto entry = std::make_unique<MessageType>();
+	try {
+		const std::string name = rosTypeName(type);
+		entry->library_ = rclcpp::get_typesupport_library(name, "rosidl_typesupport_cpp");
+		entry->type_support_ = rclcpp::get_typesupport_handle(name, "rosidl_typesupport_cpp", *entry->library_);
+		entry->introspection_library_ = rclcpp::get_typesupport_library(name, "rosidl_typesupport_introspection_cpp");
+		entry->members_ = static_cast<const ts::MessageMembers*>(
+		    rclcpp::get_typesupport_handle(name, "rosidl_typesupport_introspection_cpp", *entry->introspection_library_)
+		        ->data);
+	} catch (const std::exception& /*unused*/) {
+		entry.reset();  // not a (known) message type
+	}
+	return cache.emplace(type, std::move(entry)).first->second.get();
+}
+
+// message instance of a dynamically loaded type
+class MessageBuffer
+{
+public:
+	MessageBuffer(const ts::MessageMembers* members) : members_(members), data_(::operator new(members->size_of_)) {
+		members_->init_function(data_, rosidl_runtime_cpp::MessageInitialization::ALL);
+	}
+	~MessageBuffer() {
+		members_->fini_function(data_);
+		::operator delete(data_);
+	}
+	MessageBuffer(const MessageBuffer&) = delete;
+	MessageBuffer& operator=(const MessageBuffer&) = delete;
+
+	void* data() { return data_; }
+
+private:
+	const ts::MessageMembers* members_;
+	void* data_;
+};
+
+void writeString(std::ostream& os, const std::string& s) {
+	os << '"';
+	for (char c : s) {
+		if (c == '"' || c == '\\')
+			os << '\\' << c;
+		else if (c == '\n')
+			os << "\\n";
+		else
+			os << c;
+	}
+	os << '"';
+}
+
+template <typename T>
+void writeNumber(std::ostream& os, T value) {
+	os << std::setprecision(std::numeric_limits<T>::digits10) << value;
+}
+
+void writeMessage(std::ostream& os, const ts::MessageMembers* members, const void* msg);
+
+// write a single (non-array) value of given member type
+void writeValue(std::ostream& os, const ts::MessageMember& member, const void* value) {
+	switch (member.type_id_) {
+		case ts::ROS_TYPE_FLOAT:
+			return writeNumber(os, *static_cast<const float*>(value));
+		case ts::ROS_TYPE_DOUBLE:
+			return writeNumber(os, *static_cast<const double*>(value));
+		case ts::ROS_TYPE_LONG_DOUBLE:
+			return writeNumber(os, *static_cast<const long double*>(value));
+		case ts::ROS_TYPE_BOOLEAN:
+			os << (*static_cast<const bool*>(value) ? "true" : "false");
+			return;
+		case ts::ROS_TYPE_CHAR:
+		case ts::ROS_TYPE_OCTET:
+		case ts::ROS_TYPE_UINT8:
+			os << static_cast<unsigned int>(*static_cast<const uint8_t*>(value));
+			return;
+		case ts::ROS_TYPE_INT8:
+			os << static_cast<int>(*static_cast<const int8_t*>(value));
+			return;
+		case ts::ROS_TYPE_WCHAR:
+		case ts::ROS_TYPE_UINT16:
+			os << *static_cast<const uint16_t*>(value);
+			return;
+		case ts::ROS_TYPE_INT16:
+			os << *static_cast<const int16_t*>(value);
+			return;
+		case ts::ROS_TYPE_UINT32:
+			os << *static_cast<const uint32_t*>(value);
+			return;
+		case ts::ROS_TYPE_INT32:
+			os << *static_cast<const int32_t*>(value);
+			return;
+		case ts::ROS_TYPE_UINT64:
+			os << *static_cast<const uint64_t*>(value);
+			return;
+		case ts::ROS_TYPE_INT64:
+			os << *static_cast<const int64_t*>(value);
+			return;
+		case ts::ROS_TYPE_STRING:
+			return writeString(os, *static_cast<const std::string*>(value));
+		case ts::ROS_TYPE_WSTRING: {
+			// only show the ASCII subset
+			std::string s;
+			for (char16_t c : *static_cast<const std::u16string*>(value))
+				s.push_back(c < 128 ? static_cast<char>(c) : '?');
+			return writeString(os, s);
+		}
+		case ts::ROS_TYPE_MESSAGE:
+			return writeMessage(os, static_cast<const ts::MessageMembers*>(member.members_->data), value);
+		default:
+			os << "null";
+	}
+}
+
+void writeMember(std::ostream& os, const ts::MessageMember& member, const void* field) {
+	if (!member.is_array_)
+		return writeValue(os, member, field);
+
+	os << '[';
+	for (size_t i = 0, end = member.size_function(field); i != end; ++i) {
+		if (i)
+			os << ", ";
+		if (member.type_id_ == ts::ROS_TYPE_BOOLEAN) {  // std::vector<bool> doesn't provide element addresses
+			bool value;
+			member.fetch_function(field, i, &value);
+			writeValue(os, member, &value);
+		} else
+			writeValue(os, member, member.get_const_function(field, i));
+	}
+	os << ']';
+}
+
+// write message as YAML in flow style
+void writeMessage(std::ostream& os, const ts::MessageMembers* members, const void* msg) {
+	os << '{';
+	for (uint32_t i = 0; i != members->member_count_; ++i) {
+		const ts::MessageMember& member = members->members_[i];
+		if (i)
+			os << ", ";
+		os << member.name_ << ": ";
+		writeMember(os, member, static_cast<const uint8_t*>(msg) + member.offset_);
+	}
+	os << '}';
+}
+}  // namespace
+
+namespace moveit_rviz_plugin {
+
+bool PropertyFactory::messageToYaml(const std::string& type, const std::vector<uint8_t>& binary, std::string& yaml) {
+	const MessageType* msg_type = messageType(type);
+	if (!msg_type)
+		return false;
+
+	rclcpp::SerializedMessage serialized(binary.size());
+	auto& raw = serialized.get_rcl_serialized_message();
+	std::memcpy(raw.buffer, binary.data(), binary.size());
+	raw.buffer_length = binary.size();
+
+	MessageBuffer msg(msg_type->members_);
+	try {
+		rclcpp::SerializationBase(msg_type->type_support_).deserialize_message(&serialized, msg.data());
+	} catch (const std::exception& /*unused*/) {
+		return false;
+	}
+
+	std::ostringstream os;
+	writeMessage(os, msg_type->members_, msg.data());
+	yaml = os.str();
+	return true;
+}
+
+rviz_common::properties::Property* PropertyFactory::createDefault(const std::string& name, const std::string& type,
+                                                                  const std::string& description,
+                                                                  const std::vector<uint8_t>& binary,
+                                                                  rviz_common::properties::Property* old) {
+	std::string yaml;
+	if (!messageToYaml(type, binary, yaml))
+		yaml = "binary data (" + std::to_string(binary.size()) + " bytes)";
+	return createDefault(name, type, description, yaml, old);
+}
+}  // namespace moveit_rviz_plugin
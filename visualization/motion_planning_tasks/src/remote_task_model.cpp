@@ -35,6 +35,7 @@
 /* Author: Robert Haschke */
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "remote_task_model.h"
 #include "properties/property_factory.h"
@@ -129,7 +130,8 @@ rviz_common::properties::Property* RemoteTaskModel::Node::createProperty(
     const planning_scene::PlanningSceneConstPtr& scene_, rviz_common::DisplayContext* display_context_) {
 	auto& factory = PropertyFactory::instance();
 	// try to deserialize from msg (using registered functions)
-	boost::any value = Property::deserialize(prop.type, prop.value);
+	boost::any value = prop.binary.empty() ? Property::deserialize(prop.type, prop.value) :
+	                                         Property::deserializeBinary(prop.type, prop.binary);
 	if (!value.empty()) {  // if successful, create rviz_common::properties::Property from mtc::Property using factory
 		                    // methods
 		auto it = properties_.insert(std::make_pair(prop.name, Property())).first;
@@ -144,6 +146,8 @@ rviz_common::properties::Property* RemoteTaskModel::Node::createProperty(
 	}
 
 	// otherwise create default, read-only rviz_common::properties::Property by parsing serialized YAML
+	if (prop.value.empty() && !prop.binary.empty())  // binary value of a type unknown here: decode generically
+		return factory.createDefault(prop.name, prop.type, prop.description, prop.binary, old);
 	return factory.createDefault(prop.name, prop.type, prop.description, prop.value, old);
 }
 
@@ -344,8 +348,9 @@ void RemoteTaskModel::processStageDescriptions(
 }
 
 void RemoteTaskModel::processStageStatistics(
-    const moveit_task_constructor_msgs::msg::TaskStatistics::_stages_type& msg) {
+    const moveit_task_constructor_msgs::msg::TaskStatistics::_stages_type& msg, bool incremental) {
 	// iterate over statistics and update node's solutions where needed
+	// (incremental messages only list stages that changed and solutions added since the previous message)
 	for (const auto& s : msg) {
 		// find node for stage s, this should always exist
 		auto it = id_to_stage_.find(s.id);
@@ -354,7 +359,8 @@ void RemoteTaskModel::processStageStatistics(
 			continue;
 		}
 		Node* n = it->second;
-		n->solutions_->processSolutionIDs(s.solved, s.failed, s.num_failed, s.total_compute_time);
+		n->solutions_->processSolutionIDs(s.solved, s.failed, s.num_failed, s.total_compute_time, s.solved_costs,
+		                                  !incremental);
 
 		// emit notify about model changes when node was already visited
 		if (n->node_flags_ & WAS_VISITED) {
@@ -459,16 +465,6 @@ template <class T>
 typename T::iterator findById(T& c, decltype((*c.cbegin())->id) id) {
 	return std::find_if(c.begin(), c.end(), [id](const typename T::value_type& item) { return item->id == id; });
 }
-
-// insert new Data item into data_ container
-template <class T>
-typename T::iterator insert(T& c, typename T::value_type&& item) {
-	auto p = std::equal_range(c.begin(), c.end(), item);
-	if (p.first == p.second)  // new item
-		return c.insert(p.second, std::move(item));
-	else
-		return p.first;
-}
 }  // namespace detail
 
 RemoteSolutionModel::RemoteSolutionModel(QObject* parent) : QAbstractTableModel(parent) {}
@@ -550,14 +546,21 @@ void RemoteSolutionModel::setSolutionData(uint32_t id, float cost, const QString
 	// retrieve iterator and row corresponding to id
 	auto sit = detail::findById(sorted_, id);
 	int row = (sit != sorted_.end()) ? sit - sorted_.begin() : -1;
-	auto it = (sit != sorted_.end()) ? *sit : detail::insert(data_, Data(id, cost, 0, comment));
+	auto it = (sit != sorted_.end()) ? *sit : data_.end();
+	if (it == data_.end()) {
+		auto it_inserted = insert(id, cost, comment);
+		it = it_inserted.first;
+		if (it_inserted.second && !std::isinf(cost))
+			setSuccessful(*it, true);
+	}
 
 	QModelIndex tl, br;
 	Data& item = *it;
 	if (item.cost != cost) {
-		item.cost = cost;
+		setCost(item, cost);
 		tl = br = index(row, 1);
 	}
+	updateCostRanks();
 	if (item.comment != comment) {
 		item.comment = comment;
 		br = index(row, 2);
@@ -632,41 +635,113 @@ void RemoteSolutionModel::sortInternal() {
 }
 
 // process solution ids received in stage statistics
+// (full snapshots list all solutions, incremental updates only those added since the previous message)
 void RemoteSolutionModel::processSolutionIDs(const std::vector<uint32_t>& successful,
                                              const std::vector<uint32_t>& failed, size_t num_failed,
-                                             double total_compute_time) {
-	// append new items to the end of data_
-	processSolutionIDs(successful, true);
+                                             double total_compute_time, const std::vector<double>& costs,
+                                             bool full_snapshot) {
+	if (full_snapshot) {
+		// successful items not listed anymore were discarded (without being reported as failures)
+		std::vector<uint32_t> listed(successful);
+		std::sort(listed.begin(), listed.end());
+		for (Data& item : data_) {
+			if (item.cost_rank == std::numeric_limits<uint32_t>::max() ||
+			    std::binary_search(listed.begin(), listed.end(), item.id))
+				continue;
+			setSuccessful(item, false);
+			item.cost = std::numeric_limits<double>::infinity();
+		}
+	}
+	// insert new items into data_, maintaining creation ranks, cost index, and number of failed items
+	processSolutionIDs(successful, true, costs);
 	processSolutionIDs(failed, false);
-
-	// assign consecutive creation ranks
-	uint32_t rank = 0;
-	for (auto& item : data_)
-		item.creation_rank = ++rank;
+	updateCostRanks();
 
 	// the task may not report failure ids (in failed),
 	// but it may report the overall number of failures
-	num_failed_data_ = failed.size();  // needed to compute number of successes
 	num_failed_ = std::max(num_failed, num_failed_data_);
 	total_compute_time_ = total_compute_time;
 
 	sortInternal();
 }
 
-void RemoteSolutionModel::processSolutionIDs(const std::vector<uint32_t>& ids, bool successful) {
+void RemoteSolutionModel::processSolutionIDs(const std::vector<uint32_t>& ids, bool successful,
+                                             const std::vector<double>& costs) {
 	// Interface axiom: ids are sorted by cost
 	// insert them into data_ list sorted by id
 	double default_cost =
 	    successful ? std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::infinity();
-	uint32_t cost_rank = 0;
-	for (const uint32_t id : ids) {
-		uint32_t rank = successful ? ++cost_rank : std::numeric_limits<uint32_t>::max();
-		auto it = detail::insert(data_, Data(id, default_cost, rank));
-		Q_ASSERT(it->id == id);
-		it->cost_rank = rank;
+	const bool has_costs = costs.size() == ids.size();
+	for (size_t i = 0; i < ids.size(); ++i) {
+		Data& item = *insert(ids[i], default_cost).first;
+		Q_ASSERT(item.id == ids[i]);
+		if (!successful) {
+			setSuccessful(item, false);
+			item.cost = std::numeric_limits<double>::infinity();  // solution might have been invalidated
+			continue;
+		}
+		// (re)insert into cost index after all equally costly items, thus keeping the order of ids
+		setSuccessful(item, false);
+		if (has_costs)  // costs might have changed since the solution was listed before
+			item.cost = costs[i];
+		setSuccessful(item, true);
+	}
+}
+
+// find item with given id in data_, or insert a new (failed) one
+std::pair<RemoteSolutionModel::DataList::iterator, bool>
+RemoteSolutionModel::insert(uint32_t id, double cost, const QString& comment) {
+	// new ids are usually the largest ones: search from the back
+	auto pos = std::find_if(data_.rbegin(), data_.rend(), [id](const Data& item) { return item.id <= id; }).base();
+	if (pos != data_.begin() && std::prev(pos)->id == id)
+		return std::make_pair(std::prev(pos), false);
+
+	auto it = data_.insert(pos, Data(id, cost, std::numeric_limits<uint32_t>::max(), comment));
+	++num_failed_data_;
+	// assign consecutive creation ranks to the new and all later items
+	uint32_t rank = (it == data_.begin()) ? 0 : std::prev(it)->creation_rank;
+	for (auto next = it, end = data_.end(); next != end; ++next)
+		next->creation_rank = ++rank;
+	return std::make_pair(it, true);
+}
+
+// move item between successful (ranked by cost) and failed ones
+void RemoteSolutionModel::setSuccessful(Data& item, bool successful) {
+	if (successful == (item.cost_rank != std::numeric_limits<uint32_t>::max()))
+		return;
+
+	const double key = std::isnan(item.cost) ? std::numeric_limits<double>::infinity() : item.cost;
+	if (!dirty_cost_ || key < *dirty_cost_)
+		dirty_cost_ = key;
+	if (successful) {
+		item.cost_entry = by_cost_.emplace(key, &item);  // inserted after equal keys
+		item.cost_rank = 0;  // assigned by updateCostRanks()
+		--num_failed_data_;
+	} else {
+		by_cost_.erase(item.cost_entry);
+		item.cost_rank = std::numeric_limits<uint32_t>::max();
+		++num_failed_data_;
 	}
 }
 
+void RemoteSolutionModel::setCost(Data& item, double cost) {
+	const bool successful = item.cost_rank != std::numeric_limits<uint32_t>::max();
+	setSuccessful(item, false);  // re-index successful item under new cost
+	item.cost = cost;
+	setSuccessful(item, successful);
+}
+
+// assign consecutive cost ranks to successful items, starting from the first changed one
+void RemoteSolutionModel::updateCostRanks() {
+	if (!dirty_cost_)
+		return;
+	auto it = by_cost_.lower_bound(*dirty_cost_);
+	uint32_t rank = (it == by_cost_.begin()) ? 0 : std::prev(it)->second->cost_rank;
+	for (auto end = by_cost_.end(); it != end; ++it)
+		it->second->cost_rank = ++rank;
+	dirty_cost_.reset();
+}
+
 bool RemoteSolutionModel::isVisible(const RemoteSolutionModel::Data& item) const {
 	return std::isnan(item.cost) || item.cost <= max_cost_;
 }
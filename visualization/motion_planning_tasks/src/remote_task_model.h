@@ -42,6 +42,8 @@
 #include <rclcpp/client.hpp>
 #include <memory>
 #include <limits>
+#include <map>
+#include <optional>
 
 namespace moveit_rviz_plugin {
 
@@ -86,7 +88,8 @@ public:
 
 	QModelIndex indexFromStageId(size_t id) const override;
 	void processStageDescriptions(const moveit_task_constructor_msgs::msg::TaskDescription::_stages_type& msg);
-	void processStageStatistics(const moveit_task_constructor_msgs::msg::TaskStatistics::_stages_type& msg);
+	void processStageStatistics(const moveit_task_constructor_msgs::msg::TaskStatistics::_stages_type& msg,
+	                            bool incremental = false);
 	DisplaySolutionPtr processSolutionMessage(const moveit_task_constructor_msgs::msg::Solution& msg);
 
 	QAbstractItemModel* getSolutionModel(const QModelIndex& index) override;
@@ -99,6 +102,9 @@ public:
 class RemoteSolutionModel : public QAbstractTableModel
 {
 	Q_OBJECT
+	struct Data;
+	// successful solutions ordered by cost (unknown costs last), equal costs in order of arrival
+	using CostIndex = std::multimap<double, Data*>;
 	struct Data
 	{
 		uint32_t id;
@@ -106,6 +112,7 @@ class RemoteSolutionModel : public QAbstractTableModel
 		QString comment;
 		uint32_t creation_rank;  // rank, ordered by creation
 		uint32_t cost_rank;  // rank, ordering by cost
+		CostIndex::iterator cost_entry;  // entry in by_cost_, valid if successful
 
 		Data(uint32_t id, float cost, uint32_t cost_rank, const QString& name = QString())
 		  : id(id), cost(cost), comment(name), creation_rank(0), cost_rank(cost_rank) {}
@@ -115,6 +122,10 @@ class RemoteSolutionModel : public QAbstractTableModel
 	// successful and failed solutions ordered by id / creation
 	using DataList = std::list<Data>;
 	DataList data_;
+	// successful solutions of data_, defining their cost_rank
+	CostIndex by_cost_;
+	// smallest cost in by_cost_ from which on cost ranks need to be updated
+	std::optional<double> dirty_cost_;
 	size_t num_failed_data_ = 0;  // number of failed solutions in data_
 	size_t num_failed_ = 0;  // number of reported failures
 	double total_compute_time_ = 0.0;
@@ -126,7 +137,12 @@ class RemoteSolutionModel : public QAbstractTableModel
 	std::vector<DataList::iterator> sorted_;
 
 	inline bool isVisible(const Data& item) const;
-	void processSolutionIDs(const std::vector<uint32_t>& ids, bool successful);
+	void processSolutionIDs(const std::vector<uint32_t>& ids, bool successful,
+	                        const std::vector<double>& costs = std::vector<double>());
+	std::pair<DataList::iterator, bool> insert(uint32_t id, double cost, const QString& comment = QString());
+	void setSuccessful(Data& item, bool successful);
+	void setCost(Data& item, double cost);
+	void updateCostRanks();
 	void sortInternal();
 
 public:
@@ -143,7 +159,12 @@ public:
 	void sort(int column, Qt::SortOrder order) override;
 
 	void setSolutionData(uint32_t id, float cost, const QString& comment);
+	/** process solution ids (and optionally costs of successful ones) received in stage statistics
+	 *
+	 * A full snapshot lists all successful solutions: known ones missing in the list were discarded meanwhile.
+	 */
 	void processSolutionIDs(const std::vector<uint32_t>& successful, const std::vector<uint32_t>& failed,
-	                        size_t num_failed, double total_compute_time);
+	                        size_t num_failed, double total_compute_time,
+	                        const std::vector<double>& costs = std::vector<double>(), bool full_snapshot = false);
 };
 }  // namespace moveit_rviz_plugin
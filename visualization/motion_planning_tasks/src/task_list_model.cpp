@@ -289,7 +289,7 @@ void TaskListModel::processTaskStatisticsMessage(const moveit_task_constructor_m
 	if (!remote_task || (remote_task->taskFlags() & RemoteTaskModel::IS_DESTROYED))
 		return;  // task is not in use anymore
 
-	remote_task->processStageStatistics(msg.stages);
+	remote_task->processStageStatistics(msg.stages, msg.incremental);
 }
 
 DisplaySolutionPtr TaskListModel::processSolutionMessage(const moveit_task_constructor_msgs::msg::Solution& msg) {
@@ -0,0 +1,76 @@
+#include <properties/property_factory.h>
+#include <moveit/task_constructor/properties.h>
+
+#include <geometry_msgs/msg/pose.hpp>
+#include <moveit_task_constructor_msgs/msg/property.hpp>
+#include <gtest/gtest.h>
+
+using namespace moveit::task_constructor;
+using moveit_rviz_plugin::PropertyFactory;
+
+// serialize value like Introspection does for binary-only properties
+template <typename T>
+void serialize(const T& value, std::string& type, std::string& text, std::vector<uint8_t>& binary) {
+	PropertyMap props;
+	props.declare<T>("value", value);
+	const Property& p = props.property("value");
+	type = p.typeName();
+	p.serialize(text, binary, true);
+}
+
+TEST(PropertyFromBinary, message) {
+	geometry_msgs::msg::Pose pose;
+	pose.position.x = 1.5;
+	pose.position.y = -2.25;
+	pose.orientation.w = 1.0;
+
+	std::string type, text, yaml;
+	std::vector<uint8_t> binary;
+	serialize(pose, type, text, binary);
+	EXPECT_TRUE(text.empty());
+	ASSERT_TRUE(PropertyFactory::messageToYaml(type, binary, yaml));
+	EXPECT_EQ(yaml, "{position: {x: 1.5, y: -2.25, z: 0}, orientation: {x: 0, y: 0, z: 0, w: 1}}");
+}
+
+TEST(PropertyFromBinary, stringsAndArrays) {
+	moveit_task_constructor_msgs::msg::Property msg;
+	msg.name = "a \"quoted\" name";
+	msg.description = "line\nbreak";
+	msg.binary = { 1, 2, 255 };
+
+	std::string type, text, yaml;
+	std::vector<uint8_t> binary;
+	serialize(msg, type, text, binary);
+	ASSERT_TRUE(PropertyFactory::messageToYaml(type, binary, yaml));
+	EXPECT_EQ(yaml,
+	          R"({name: "a \"quoted\" name", description: "line\nbreak", type: "", value: "", binary: [1, 2, 255]})");
+}
+
+TEST(PropertyFromBinary, unknownType) {
+	std::string yaml;
+	EXPECT_FALSE(PropertyFactory::messageToYaml("unknown_msgs::msg::Unknown", { 0, 1, 0, 0 }, yaml));
+	EXPECT_FALSE(PropertyFactory::messageToYaml(typeid(double).name(), { 0, 1, 0, 0 }, yaml));
+	EXPECT_TRUE(yaml.empty());
+}
+
+// arithmetic types don't have a binary form, but are always transmitted as text
+template <typename T>
+void checkArithmetic(T value) {
+	std::string type, text;
+	std::vector<uint8_t> binary;
+	serialize(value, type, text, binary);
+	EXPECT_TRUE(binary.empty()) << type;
+	EXPECT_EQ(boost::any_cast<T>(Property::deserialize(type, text)), value) << type;
+}
+
+TEST(PropertyFromBinary, arithmetic) {
+	checkArithmetic<bool>(true);
+	checkArithmetic<short>(-42);
+	checkArithmetic<unsigned short>(42);
+	checkArithmetic<int>(-123456);
+	checkArithmetic<unsigned int>(123456u);
+	checkArithmetic<long>(-1234567890l);
+	checkArithmetic<unsigned long>(1234567890ul);
+	checkArithmetic<float>(0.25f);
+	checkArithmetic<double>(-1.5);
+}
@@ -55,3 +55,46 @@ TEST_F(SolutionModelTest, sorting) {
 	processAndValidate({ 1, 3 }, { 2 });
 	processAndValidate({ 4, 1, 6, 3 }, { 5, 2 });
 }
+
+TEST_F(SolutionModelTest, incremental) {
+	RemoteSolutionModel model;
+	model.processSolutionIDs({ 1, 3 }, {}, 0, 0.0, { 2.0, 4.0 });
+	// new solutions are ranked by cost among all previous ones
+	model.processSolutionIDs({ 4, 5 }, { 2 }, 1, 0.0, { 1.0, 3.0 });
+	EXPECT_EQ(model.numSuccessful(), 4u);
+	EXPECT_EQ(model.numFailed(), 1u);
+	validateSorting(model, 0, Qt::AscendingOrder, { 1, 2, 3, 4, 5 });
+	validateSorting(model, 1, Qt::AscendingOrder, { 4, 1, 5, 3, 2 });
+
+	// an invalidated solution moves from successful to failed ones
+	model.processSolutionIDs({}, { 1 }, 2, 0.0);
+	EXPECT_EQ(model.numSuccessful(), 3u);
+	EXPECT_EQ(model.numFailed(), 2u);
+	validateSorting(model, 1, Qt::DescendingOrder, { 2, 1, 3, 5, 4 });
+}
+
+TEST_F(SolutionModelTest, fullSnapshot) {
+	RemoteSolutionModel model;
+	model.processSolutionIDs({ 1, 2, 3 }, {}, 0, 0.0, { 1.0, 2.0, 3.0 });
+	EXPECT_EQ(model.numSuccessful(), 3u);
+
+	// incremental updates only add solutions
+	model.processSolutionIDs({ 4 }, {}, 0, 0.0, { 4.0 });
+	EXPECT_EQ(model.numSuccessful(), 4u);
+
+	// a full snapshot not listing a successful solution anymore indicates its discard
+	model.processSolutionIDs({ 1, 3, 4 }, {}, 1, 0.0, { 1.0, 3.0, 4.0 }, true);
+	EXPECT_EQ(model.numSuccessful(), 3u);
+	EXPECT_EQ(model.numFailed(), 1u);
+	validateSorting(model, 1, Qt::AscendingOrder, { 1, 3, 4, 2 });
+}
+
+TEST_F(SolutionModelTest, updatedCosts) {
+	RemoteSolutionModel model;
+	model.processSolutionIDs({ 1, 2, 3 }, {}, 0, 0.0, { 1.0, 2.0, 3.0 });
+
+	// a solution listed again with a changed cost is re-ranked
+	model.processSolutionIDs({ 2 }, {}, 0, 0.0, { 4.0 });
+	EXPECT_EQ(model.numSuccessful(), 3u);
+	validateSorting(model, 1, Qt::AscendingOrder, { 1, 3, 2 });
+}